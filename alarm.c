@@ -0,0 +1,98 @@
+#include "app.h"
+#include "alarm.h"
+#include "disp.h"
+#include "lcd1602.h"
+#include "calendar.h"
+#include "timing.h"
+#include "eventlog.h"
+
+// =========================================================
+// 闹钟：触发判断、响铃计时、非阻塞蜂鸣
+// =========================================================
+
+#define ALARM_RING_SECONDS  30  // 无人按键时响铃多久自动停止
+
+// CheckAlarm 每轮都要比较闹钟设置，和响铃标志一样留在 DATA
+u8 Alarm_Hour = 7;
+u8 Alarm_Min  = 0;
+u8 alarm_enabled = 1; // 0: off, 1: on (persisted to DS1302 RAM 3)
+u8 alarm_triggered = 0;
+
+static u8 alarm_latched = 0;    // 本次闹钟分钟内已经触发过（关掉后同一分钟内不再响）
+static u8 alarm_duration = 0;   // 已响铃秒数（按 RTC 秒变化计）
+static u8 alarm_last_sec = 0;   // 上次计时时的秒 (BCD)
+// 非阻塞蜂鸣控制（闹钟响铃期间使用）
+static u8 alarm_beep_active = 0;
+static u8 alarm_beep_tick = 0;
+static u8 alarm_lcd_tick = 0;
+
+void Alarm_Start(void) {
+    alarm_triggered = 1;
+    alarm_duration = 0;
+    alarm_last_sec = Time[0];
+    BEEP = 0; // 低电平有效，开始蜂鸣
+    // 启动非阻塞蜂鸣循环并重置计数器
+    alarm_beep_active = 1;
+    alarm_beep_tick = 0;
+    alarm_lcd_tick = 0;
+}
+
+// 停止响铃并记录原因（EV_ALARM_DISMISSED / EV_ALARM_AUTOSTOP）
+void AlarmStop(u8 ev) {
+    alarm_triggered = 0;
+    BEEP = 1;
+    alarm_beep_active = 0;
+    EventLog_Append(ev, alarm_duration, Time);
+    alarm_duration = 0;
+}
+
+void CheckAlarm(void) {
+    // 触发条件：闹钟开启，进入闹钟那一分钟后的第一轮就响，每分钟只触发一次。
+    // 主循环被拖慢时照样会响，晚了几秒如实记录下来
+    if(Cal_MinuteOfDay(Time) != (u16)Alarm_Hour * 60 + Alarm_Min) {
+        alarm_latched = 0;
+    } else if(alarm_enabled && !alarm_triggered && !alarm_latched) {
+        alarm_latched = 1;
+        // 记录触发时晚了几秒，用来统计真实的闹钟延迟
+        EventLog_Append(EV_ALARM_FIRED, BCD_to_Decimal(Time[0]), Time);
+        Alarm_Start();
+    }
+
+    if(alarm_triggered) {
+        // 按 RTC 秒变化计时，与主循环快慢无关
+        if(Time[0] != alarm_last_sec) {
+            alarm_last_sec = Time[0];
+            alarm_duration++;
+        }
+        if(alarm_duration >= ALARM_RING_SECONDS) { // 30秒后自动关闭
+            AlarmStop(EV_ALARM_AUTOSTOP);
+        }
+    }
+
+    // 任何按键都可以关闭闹钟
+    if(alarm_triggered && (KEY_MODE == 0 || KEY_SEL == 0 || KEY_UP == 0 || KEY_DOWN == 0)) {
+        // 用户按键关闭闹钟，停止蜂鸣并刷新屏幕
+        AlarmStop(EV_ALARM_DISMISSED);
+        LCD_WriteCmd(0x01);
+        DelayMs(200); // 消抖
+    }
+}
+
+// 非阻塞蜂鸣控制：如果处于闹钟响铃状态，以固定节拍切换 BEEP
+void Alarm_Beep(void) {
+    if(!alarm_beep_active) return;
+
+    alarm_beep_tick++;
+    if(alarm_beep_tick >= 2) { // 2 * 50ms = ~100ms 切换一次
+        alarm_beep_tick = 0;
+        BEEP = !BEEP;
+    }
+    // 周期性刷新屏幕（每 ~500ms）以保持显示更新
+    alarm_lcd_tick++;
+    if(alarm_lcd_tick >= 10) {
+        alarm_lcd_tick = 0;
+        // 如果当前在闹钟显示界面，刷新闹钟界面；否则刷新时间界面
+        if(mode == MODE_ALARM) DisplayAlarm();
+        else DisplayTime();
+    }
+}
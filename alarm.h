@@ -0,0 +1,16 @@
+#ifndef __ALARM_H__
+#define __ALARM_H__
+
+#include "common.h"
+
+extern u8 Alarm_Hour;
+extern u8 Alarm_Min;
+extern u8 alarm_enabled;    // 0: 关, 1: 开 (DS1302 RAM 3)
+extern u8 alarm_triggered;  // 响铃期间为 1
+
+void Alarm_Start(void);     // 开始响铃（非阻塞）
+void AlarmStop(u8 ev);      // 停止响铃，记录 EV_ALARM_DISMISSED / EV_ALARM_AUTOSTOP
+void CheckAlarm(void);      // 主循环每轮一次，在 Time[] 更新之后
+void Alarm_Beep(void);      // 主循环每轮一次：蜂鸣节拍 + 刷新屏幕
+
+#endif
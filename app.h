@@ -0,0 +1,36 @@
+#ifndef __APP_H__
+#define __APP_H__
+
+#include "reg52.h"
+#include "common.h"
+
+// 按键和蜂鸣器
+sbit KEY_MODE  = P3^1;  // K1 - 模式 / 退出
+sbit KEY_SEL   = P3^0;  // K2 - 选择
+sbit KEY_UP    = P3^2;  // K3 - 加
+sbit KEY_DOWN  = P3^3;  // K4 - 减
+sbit BEEP      = P2^0;  // 低电平有效
+
+// 界面，用 K1 轮换
+#define MODE_TIME       0
+#define MODE_ALARM      1
+#define MODE_HISTORY    2
+#define MODE_SET_ALARM  3
+#define MODE_SET_TIME   4
+#define MODE_COUNT      5
+
+// 保存在 DS1302 RAM 里的设置（事件记录从 RAM 6 开始）
+#define RAM_CHECK_ADDR  0x00
+#define RAM_ALARM_H     0x01
+#define RAM_ALARM_M     0x02
+#define RAM_ALARM_EN    0x03
+#define RAM_HOUR_MODE   0x04
+#define RAM_HOURLY_EN   0x05
+
+extern u8 Time[7];          // 当前时间，BCD，布局同 DS1302_ReadTime
+extern u8 xdata Temp_Time[7];   // 时间编辑器的工作副本
+extern u8 mode;
+extern u8 setting_mode;     // 编辑器打开期间为 1
+extern u8 fast_mode;        // 按键按住（连发）期间为 1
+
+#endif
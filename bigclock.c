@@ -0,0 +1,130 @@
+#include "bigclock.h"
+#include "lcd1602.h"
+#include "calendar.h"
+#include "text.h"
+
+#if FEATURE_BIGCLOCK
+
+// =========================================================
+// 大字时钟：每个数字占 3 列 x 2 行，由 8 个 CGRAM 段形拼出
+// 布局：时 0..5 列，冒号 6 列，分 7..12 列，秒(小字) 第 2 行 14..15 列，
+//       AM/PM(12 小时制) 第 1 行 14..15 列
+// =========================================================
+
+#define SEG_LT   0      // 左上圆角
+#define SEG_UB   1      // 上横
+#define SEG_RT   2      // 右上圆角
+#define SEG_LL   3      // 左下圆角
+#define SEG_LB   4      // 下横
+#define SEG_LR   5      // 右下圆角
+#define SEG_UMB  6      // 上横 + 中横上半
+#define SEG_LMB  7      // 中横下半 + 下横
+#define SEG_BLK  0xFF   // 字库自带的实心块
+#define SEG_SPC  0x20
+
+static u8 code big_glyphs[8][8] = {
+    { 0x07, 0x0F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F },    // LT
+    { 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00 },    // UB
+    { 0x1C, 0x1E, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F },    // RT
+    { 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x0F, 0x07 },    // LL
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F },    // LB
+    { 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1E, 0x1C },    // LR
+    { 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x1F, 0x1F },    // UMB
+    { 0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F }     // LMB
+};
+
+// 每个数字 6 个单元：前 3 个是上行，后 3 个是下行
+static u8 code big_digit_cells[10][6] = {
+    { SEG_LT,  SEG_UB,  SEG_RT,   SEG_LL,  SEG_LB,  SEG_LR  },  // 0
+    { SEG_UB,  SEG_RT,  SEG_SPC,  SEG_LB,  SEG_BLK, SEG_LB  },  // 1
+    { SEG_UMB, SEG_UMB, SEG_RT,   SEG_LL,  SEG_LMB, SEG_LMB },  // 2
+    { SEG_UMB, SEG_UMB, SEG_RT,   SEG_LMB, SEG_LMB, SEG_LR  },  // 3
+    { SEG_LL,  SEG_LB,  SEG_BLK,  SEG_SPC, SEG_SPC, SEG_BLK },  // 4
+    { SEG_LL,  SEG_UMB, SEG_UMB,  SEG_LMB, SEG_LMB, SEG_LR  },  // 5
+    { SEG_LT,  SEG_UMB, SEG_UMB,  SEG_LL,  SEG_LMB, SEG_LR  },  // 6
+    { SEG_UB,  SEG_UB,  SEG_RT,   SEG_SPC, SEG_SPC, SEG_BLK },  // 7
+    { SEG_LT,  SEG_UMB, SEG_RT,   SEG_LL,  SEG_LMB, SEG_LR  },  // 8
+    { SEG_LT,  SEG_UMB, SEG_RT,   SEG_LMB, SEG_LMB, SEG_LR  }   // 9
+};
+
+static u8 code big_digit_col[4] = { 0, 3, 7, 10 };
+
+// 屏幕影子缓存放在片内 XRAM
+static u8 xdata big_glyphs_loaded = 0;
+static u8 xdata big_clear_seq;  // 上次整屏重画时的 lcd_clear_seq
+static u8 xdata big_shown[4];   // 屏上 HHMM 四位，0xFF 表示未知
+static u8 xdata big_sec_shown;  // 屏上秒 (BCD)
+static u8 xdata big_ampm_shown; // 0:无 1:AM 2:PM
+
+static void BigClock_Invalidate(void) {
+    u8 i;
+    for(i = 0; i < 4; i++) big_shown[i] = 0xFF;
+    big_sec_shown = 0xFF;
+    big_ampm_shown = 0xFF;
+    big_clear_seq = lcd_clear_seq;
+}
+
+void BigClock_Enter(void) {
+    u8 i;
+    if(!big_glyphs_loaded) {
+        for(i = 0; i < 8; i++) LCD_SetGlyph(i, big_glyphs[i]);
+        big_glyphs_loaded = 1;
+    }
+    big_clear_seq = lcd_clear_seq - 1;  // 让下一次 Show 整屏重画
+}
+
+static void BigClock_Digit(u8 pos, u8 d) {
+    u8 i;
+    u8 code *cell = big_digit_cells[d];
+    u8 col = big_digit_col[pos];
+
+    LCD_WriteCmd(0x80 | col);
+    for(i = 0; i < 3; i++) LCD_WriteData(cell[i]);
+    LCD_WriteCmd(0x80 | 0x40 | col);
+    for(i = 3; i < 6; i++) LCD_WriteData(cell[i]);
+    big_shown[pos] = d;
+}
+
+void BigClock_Show(u8 *t, u8 hour_mode) {
+    u8 h24 = BCD_to_Decimal(t[2]);
+    u8 h = h24;
+    u8 min = BCD_to_Decimal(t[1]);
+    u8 ampm = 0;
+    u8 digits[4];
+    u8 i;
+
+    // 清屏过（切换模式、12/24 切换等）就整屏重画
+    if(big_clear_seq != lcd_clear_seq) {
+        BigClock_Invalidate();
+        LCD_ShowChar(0, 6, 0xA5);   // 冒号用上下两个中点
+        LCD_ShowChar(1, 6, 0xA5);
+    }
+
+    if(hour_mode) {
+        if(h24 == 0) h = 12;
+        else if(h24 > 12) h = h24 - 12;
+        ampm = (h24 < 12) ? 1 : 2;
+    }
+
+    digits[0] = h / 10;
+    digits[1] = h % 10;
+    digits[2] = min / 10;
+    digits[3] = min % 10;
+    for(i = 0; i < 4; i++) {
+        if(big_shown[i] != digits[i]) BigClock_Digit(i, digits[i]);
+    }
+
+    if(big_sec_shown != t[0]) {
+        LCD_ShowNum(1, 14, BCD_to_Decimal(t[0]), 2);
+        big_sec_shown = t[0];
+    }
+
+    if(big_ampm_shown != ampm) {
+        if(ampm == 1) Text_Show(0, 14, TXT_AM, 2);
+        else if(ampm == 2) Text_Show(0, 14, TXT_PM, 2);
+        else Text_Show(0, 14, TXT_BLANK, 2);
+        big_ampm_shown = ampm;
+    }
+}
+
+#endif
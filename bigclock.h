@@ -0,0 +1,10 @@
+#ifndef __BIGCLOCK_H__
+#define __BIGCLOCK_H__
+
+#include "common.h"
+
+// 时间界面的两行大字（HH:MM 用大字，秒用小字）
+void BigClock_Enter(void);                  // 只上传一次 CGRAM 笔段，并强制整屏重画
+void BigClock_Show(u8 *t, u8 hour_mode);    // 只重写有变化的格子
+
+#endif
@@ -0,0 +1,92 @@
+#include "calendar.h"
+
+// 平年每月天数（二月在 Cal_DaysInMonth 里按闰年修正）
+static u8 code month_days[12] = {
+    31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+};
+
+// 平年中每月 1 号之前已经过去的天数
+static u16 code month_offset[12] = {
+    0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334
+};
+
+// BCD转十进制
+u8 BCD_to_Decimal(u8 bcd) {
+    return ((bcd >> 4) * 10) + (bcd & 0x0F);
+}
+
+// 十进制转BCD
+u8 Decimal_to_BCD(u8 decimal) {
+    return ((decimal / 10) << 4) | (decimal % 10);
+}
+
+// 2000..2099 区间内能被 4 整除即为闰年（2000 年本身也是闰年）
+u8 Cal_IsLeapYear(u8 year) {
+    return (year & 0x03) == 0;
+}
+
+u8 Cal_DaysInMonth(u8 year, u8 month) {
+    if(month < 1 || month > 12) return 31;
+    if(month == 2 && Cal_IsLeapYear(year)) return 29;
+    return month_days[month - 1];
+}
+
+// 以 2000-01-01（周六）为基准累加天数，再对 7 取余
+u8 Cal_Weekday(u8 year, u8 month, u8 day) {
+    u16 days;
+
+    // RTC 数据损坏时月份可能越界，按 1 月算，免得读到表外
+    if(month < 1 || month > 12) month = 1;
+    days = (u16)year * 365 + ((year + 3) >> 2); // 之前各年的天数 + 闰日
+    days += month_offset[month - 1] + day - 1;
+    if(month > 2 && Cal_IsLeapYear(year)) days++;
+
+    return (u8)((days + 5) % 7) + 1;            // 0 天 -> 6 (周六)
+}
+
+u8 Cal_IsTimeValid(u8 *t) {
+    u8 sec = BCD_to_Decimal(t[0]);
+    u8 min = BCD_to_Decimal(t[1]);
+    u8 hour = BCD_to_Decimal(t[2]);
+    u8 day = BCD_to_Decimal(t[3]);
+    u8 month = BCD_to_Decimal(t[4]);
+    u8 week = BCD_to_Decimal(t[5]);
+    u8 year = BCD_to_Decimal(t[6]);
+
+    if(sec > 59) return 0;
+    if(min > 59) return 0;
+    if(hour > 23) return 0;
+    if(year > 99) return 0;
+    if(month < 1 || month > 12) return 0;
+    if(day < 1 || day > Cal_DaysInMonth(year, month)) return 0;
+    if(week < 1 || week > 7) return 0;
+    return 1;
+}
+
+u8 Cal_Normalize(u8 *t) {
+    u8 year = BCD_to_Decimal(t[6]);
+    u8 month = BCD_to_Decimal(t[4]);
+    u8 day = BCD_to_Decimal(t[3]);
+    u8 dim = Cal_DaysInMonth(year, month);
+    u8 week, changed = 0;
+
+    if(day > dim) {
+        day = dim;
+        t[3] = Decimal_to_BCD(day);
+        changed = 1;
+    }
+    week = Decimal_to_BCD(Cal_Weekday(year, month, day));
+    if(t[5] != week) {
+        t[5] = week;
+        changed = 1;
+    }
+    return changed;
+}
+
+u16 Cal_MinuteOfDay(u8 *t) {
+    return (u16)BCD_to_Decimal(t[2]) * 60 + BCD_to_Decimal(t[1]);
+}
+
+u16 Cal_MinuteOfWeek(u8 *t) {
+    return (u16)(BCD_to_Decimal(t[5]) - 1) * 1440 + Cal_MinuteOfDay(t);
+}
@@ -0,0 +1,25 @@
+#ifndef __CALENDAR_H__
+#define __CALENDAR_H__
+
+#include "common.h"
+
+// 时间数组布局与 DS1302_ReadTime 一致（全部为 BCD）：
+// t[0]=秒 t[1]=分 t[2]=时 t[3]=日 t[4]=月 t[5]=周(1=周一..7=周日) t[6]=年(20xx)
+
+u8 BCD_to_Decimal(u8 bcd);
+u8 Decimal_to_BCD(u8 decimal);
+
+u8 Cal_IsLeapYear(u8 year);                 // year: 0..99 表示 2000..2099
+u8 Cal_DaysInMonth(u8 year, u8 month);      // month: 1..12
+u8 Cal_Weekday(u8 year, u8 month, u8 day);  // 返回 1..7
+
+// 校验 BCD 时间（含大小月、闰年、星期范围）
+u8 Cal_IsTimeValid(u8 *t);
+// 把日期夹到当月天数以内，并按年月日重新计算星期；返回 1 表示 t 被修改
+u8 Cal_Normalize(u8 *t);
+
+// 压缩表示：一天内的分钟数 (0..1439)、一周内的分钟数 (0..10079)
+u16 Cal_MinuteOfDay(u8 *t);
+u16 Cal_MinuteOfWeek(u8 *t);
+
+#endif
@@ -0,0 +1,38 @@
+#include "app.h"
+#include "chime.h"
+#include "ds1302.h"
+#include "calendar.h"
+#include "timing.h"
+
+#if FEATURE_CHIME
+
+// =========================================================
+// 整点报时
+// =========================================================
+
+u8 xdata hourly_chime = 0; // 0: 关闭整点报时, 1: 开启
+
+void Chime_Check(void) {
+    static u16 xdata last_chime = 0xFFFF; // 上次报时的周内分钟数，防止同一整点重复响
+    u16 now = Cal_MinuteOfWeek(Time);
+
+    // 按十进制分钟判断整点；进入整点那一分钟后的第一轮就响，
+    // 主循环被拖慢错过 00 秒也不会漏报（同 CheckAlarm）
+    if(hourly_chime && Cal_MinuteOfDay(Time) % 60 == 0) {
+        if(last_chime != now) {
+            // 触发报时：嘀-嘀 两声
+            BEEP = 0; DelayMs(100); BEEP = 1; DelayMs(100);
+            BEEP = 0; DelayMs(100); BEEP = 1;
+            last_chime = now; // 标记这个整点已经响过了
+        }
+    }
+}
+
+void Chime_Toggle(void) {
+    hourly_chime = !hourly_chime; // 切换状态
+    DS1302_WriteRam(RAM_HOURLY_EN, hourly_chime); // 立即保存
+    // 蜂鸣器叫一声提示状态变化
+    BEEP = 0; DelayMs(100); BEEP = 1;
+}
+
+#endif
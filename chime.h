@@ -0,0 +1,13 @@
+#ifndef __CHIME_H__
+#define __CHIME_H__
+
+#include "common.h"
+
+#if FEATURE_CHIME
+extern u8 xdata hourly_chime;   // 0: 关, 1: 开 (DS1302 RAM 5)
+
+void Chime_Check(void);     // 主循环每轮一次，在 Time[] 更新之后
+void Chime_Toggle(void);    // 切换、保存，并响一声确认
+#endif
+
+#endif
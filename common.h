@@ -4,4 +4,6 @@
 typedef unsigned char u8;
 typedef unsigned int  u16;
 
+#include "config.h"
+
 #endif
\ No newline at end of file
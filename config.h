@@ -0,0 +1,60 @@
+#ifndef __CONFIG_H__
+#define __CONFIG_H__
+
+// =========================================================
+// 功能开关：1 = 编进固件，0 = 不编入。
+// 每个模块占多少 ROM/RAM，用 tools/m51size.py 看 .m51 映射文件。
+// =========================================================
+#ifndef FEATURE_12H
+#define FEATURE_12H         1   // 12 小时制显示（时间界面 K3）
+#endif
+#ifndef FEATURE_CHIME
+#define FEATURE_CHIME       1   // 整点报时（时间界面 K4）
+#endif
+#ifndef FEATURE_BIGCLOCK
+#define FEATURE_BIGCLOCK    1   // 两行大字（时间界面 K2）
+#endif
+#ifndef FEATURE_EVENTLOG
+#define FEATURE_EVENTLOG    1   // 事件记录写入 DS1302 RAM（闹钟延迟等，可在台上读出）
+#endif
+#ifndef FEATURE_HISTORY
+#define FEATURE_HISTORY     1   // 历史界面，查看事件记录
+#endif
+// 下面两项只给调试台用，出货固件默认不编入
+#ifndef FEATURE_DEBUG_RING
+#define FEATURE_DEBUG_RING  0   // 闹钟界面 K3 开始/停止响铃
+#endif
+#ifndef FEATURE_BUS_STATS
+#define FEATURE_BUS_STATS   0   // LCD/DS1302 总线字节数峰值（历史界面 K2）
+#endif
+
+// 软件时钟 (softclock.c)：每隔多少秒回读一次 DS1302（每分钟跳变时也会读），
+// 以及测量多长时间的漂移后再微调 Timer2 重装值
+#ifndef SOFTCLOCK_RESYNC_S
+#define SOFTCLOCK_RESYNC_S      20
+#endif
+#ifndef SOFTCLOCK_TRIM_WINDOW_S
+#define SOFTCLOCK_TRIM_WINDOW_S 3600
+#endif
+// 窗口满了还要等累计偏差至少这么多秒才修正（每次对时有 ±1 秒的量化误差）
+#ifndef SOFTCLOCK_TRIM_MIN_S
+#define SOFTCLOCK_TRIM_MIN_S    8
+#endif
+
+// DS1302 边沿时序校准 (ds1302.c)：在测出的最快可用级别上再慢几级留余量，
+// 0 级（手册最小时序）也一样；0 = 不留余量，直接用最快通过的级别
+#ifndef DS1302_CAL_MARGIN
+#define DS1302_CAL_MARGIN       1
+#endif
+
+// 历史界面要读事件记录；总线统计显示在历史界面上
+#if FEATURE_HISTORY && !FEATURE_EVENTLOG
+#undef  FEATURE_HISTORY
+#define FEATURE_HISTORY     0
+#endif
+#if FEATURE_BUS_STATS && !FEATURE_HISTORY
+#undef  FEATURE_BUS_STATS
+#define FEATURE_BUS_STATS   0
+#endif
+
+#endif
@@ -0,0 +1,149 @@
+#include "app.h"
+#include "diag.h"
+#include "alarm.h"
+#include "lcd1602.h"
+#include "ds1302.h"
+#include "timing.h"
+#include "eventlog.h"
+#include "text.h"
+
+// =========================================================
+// 调试/诊断：事件记录界面、总线流量统计、手动响铃
+// =========================================================
+
+#if FEATURE_HISTORY
+static u8 xdata history_pos = 0;  // 事件记录界面当前显示第几条（0 = 最新）
+
+// 事件记录界面
+// 第一行：序号 + 事件名；第二行：月-日 时:分，闹钟类事件附带秒数（延迟/响铃时长），
+// 开机记录附带合并的开机次数
+static u8 code event_text[] = {
+    TXT_EV_NONE,
+    TXT_EV_POWER_ON,
+    TXT_EV_RTC_INVALID,
+    TXT_EV_TIME_SET,
+    TXT_EV_ALARM_FIRED,
+    TXT_EV_ALARM_OFF,
+    TXT_EV_ALARM_AUTO
+};
+
+static void DisplayHistory(void) {
+    u8 e[EVLOG_ENTRY_SIZE];
+    u8 ev;
+    u16 mod;
+
+    if(!EventLog_Get(history_pos, e)) {
+        Text_Show(0, 0, TXT_NO_HISTORY, 16);
+        Text_Show(1, 0, TXT_BLANK, 16);
+        return;
+    }
+
+    ev = EVLOG_CODE(e);
+    if(ev > EV_ALARM_AUTOSTOP) ev = EV_NONE;
+    mod = EVLOG_MINUTE(e);
+
+    LCD_ShowNum(0, 0, history_pos + 1, 1);
+    LCD_ShowChar(0, 1, ' ');
+    Text_Show(0, 2, event_text[ev], 14);
+
+    LCD_ShowNum(1, 0, EVLOG_MONTH(e), 2);
+    LCD_ShowChar(1, 2, '-');
+    LCD_ShowNum(1, 3, EVLOG_DAY(e), 2);
+    LCD_ShowChar(1, 5, ' ');
+    LCD_ShowNum(1, 6, mod / 60, 2);
+    LCD_ShowChar(1, 8, ':');
+    LCD_ShowNum(1, 9, mod % 60, 2);
+    if(ev >= EV_ALARM_FIRED) {
+        LCD_ShowChar(1, 11, ' ');
+        LCD_ShowNum(1, 12, EVLOG_ARG(e), 3);
+        LCD_ShowChar(1, 15, 's');
+    } else if(ev == EV_POWER_ON) {
+        LCD_ShowChar(1, 11, ' ');
+        LCD_ShowChar(1, 12, 'x');
+        LCD_ShowNum(1, 13, EVLOG_ARG(e), 3);
+    } else {
+        Text_Show(1, 11, TXT_BLANK, 5);
+    }
+}
+#endif
+
+#if FEATURE_BUS_STATS
+// 各界面单次主循环（无按键、未响铃）的总线字节数峰值，按 mode 编号排列，
+// 在台上看实际流量用。字节数是否超标由 tools/host 的场景对照 golden 检查
+static u8 xdata bus_peak_lcd[MODE_COUNT];
+static u8 xdata bus_peak_rtc[MODE_COUNT];
+static u8 xdata history_bus = 0;  // 事件记录界面按 K2 切到总线流量统计
+
+static u16 bus_lcd_start, bus_rtc_start;
+static u8 bus_ring;
+
+void BusStats_Begin(void) {
+    bus_lcd_start = lcd_bus_bytes;
+    bus_rtc_start = ds1302_bus_bytes;
+    bus_ring = alarm_triggered;
+}
+
+// 记录本次循环的字节数峰值
+// 只统计稳态刷新：按键和响铃会额外写屏/写 RAM，不计入峰值
+void BusStats_End(u8 key) {
+    u16 lcd, rtc;
+
+    if(key != 0 || bus_ring || alarm_triggered) return;
+
+    lcd = lcd_bus_bytes - bus_lcd_start;
+    rtc = ds1302_bus_bytes - bus_rtc_start;
+    if(lcd > 255) lcd = 255;
+    if(rtc > 255) rtc = 255;
+    if(bus_peak_lcd[mode] < lcd) bus_peak_lcd[mode] = lcd;
+    if(bus_peak_rtc[mode] < rtc) bus_peak_rtc[mode] = rtc;
+}
+
+// 第一行 LCD、第二行 DS1302：每个界面一个峰值
+static void DisplayBusStats(void) {
+    u8 i, v;
+    LCD_ShowChar(0, 0, 'L');
+    LCD_ShowChar(1, 0, 'R');
+    for(i = 0; i < MODE_COUNT; i++) {
+        v = bus_peak_lcd[i];
+        LCD_ShowNum(0, 2 + i * 3, v > 99 ? 99 : v, 2);
+        v = bus_peak_rtc[i];
+        LCD_ShowNum(1, 2 + i * 3, v > 99 ? 99 : v, 2);
+    }
+}
+#endif
+
+#if FEATURE_HISTORY
+void Diag_HistoryScreen(u8 key) {
+#if FEATURE_BUS_STATS
+    if(key == 2) {
+        history_bus = !history_bus;
+        LCD_WriteCmd(0x01);
+    }
+    if(history_bus) {
+        DisplayBusStats();
+        return;
+    }
+#endif
+    DisplayHistory();
+    // K3 看更早的一条，K4 看更新的一条
+    if(key == 3 && history_pos + 1 < EventLog_Count()) history_pos++;
+    if(key == 4 && history_pos > 0) history_pos--;
+}
+#endif
+
+#if FEATURE_DEBUG_RING
+// 方便调试：在闹钟显示界面按 KEY_UP (K3) 手动切换闹钟响铃状态
+void Diag_DebugRing(void) {
+    if(!alarm_triggered) {
+        // 启动闹钟（与自动触发一致的非阻塞行为）
+        Alarm_Start();
+        // 等待按键释放，避免同次按键被检测为关闭闹钟
+        while(KEY_UP == 0) DelayMs(10);
+    } else {
+        // 如果已经在响铃，按一次停止（与其他按键行为一致）
+        AlarmStop(EV_ALARM_DISMISSED);
+        LCD_WriteCmd(0x01);
+        DelayMs(200);
+    }
+}
+#endif
@@ -0,0 +1,19 @@
+#ifndef __DIAG_H__
+#define __DIAG_H__
+
+#include "common.h"
+
+#if FEATURE_HISTORY
+void Diag_HistoryScreen(u8 key);    // MODE_HISTORY：K3 更早，K4 更新（K2 总线统计）
+#endif
+
+#if FEATURE_BUS_STATS
+void BusStats_Begin(void);          // 主循环每轮开头
+void BusStats_End(u8 key);          // 每轮结尾：记录当前界面本轮的字节数峰值
+#endif
+
+#if FEATURE_DEBUG_RING
+void Diag_DebugRing(void);          // 开始响铃，已在响则停止
+#endif
+
+#endif
@@ -0,0 +1,171 @@
+#include "app.h"
+#include "disp.h"
+#include "alarm.h"
+#include "chime.h"
+#include "diag.h"
+#include "lcd1602.h"
+#include "ds1302.h"
+#include "calendar.h"
+#include "timing.h"
+#include "bigclock.h"
+#include "text.h"
+#include "softclock.h"
+
+// =========================================================
+// 显示界面：时间 (MODE_TIME) 与闹钟 (MODE_ALARM)
+// =========================================================
+
+#if FEATURE_12H
+u8 xdata hour_mode = 0;    // 0: 24小时制, 1: 12小时制
+#define HOUR_MODE   hour_mode
+#else
+#define HOUR_MODE   0
+#endif
+#if FEATURE_BIGCLOCK
+u8 xdata big_digits = 0;   // 0: 普通文字时钟, 1: 两行大字时钟
+#endif
+
+// RTC 降级（只靠软件时钟走时）时在第一行第 13 列显示 '!'，
+// 大字和普通界面都不用这一格；只在变化或清屏后重画
+static void DisplayRtcFlag(void) {
+    static u8 xdata flag_shown = 0xFF;
+    static u8 xdata flag_seq;
+
+    if(flag_shown != soft_degraded || flag_seq != lcd_clear_seq) {
+        LCD_ShowChar(0, 13, soft_degraded ? '!' : ' ');
+        flag_shown = soft_degraded;
+        flag_seq = lcd_clear_seq;
+    }
+}
+
+// 时间显示
+// --- 【修改后的显示时间函数】 ---
+void DisplayTime(void) {
+    u8 h24;
+#if FEATURE_12H
+    u8 h12;
+#endif
+    DisplayRtcFlag();
+
+#if FEATURE_BIGCLOCK
+    // 大字模式只改写变化的数字格，其余内容保持不动
+    if(big_digits) {
+        BigClock_Show(Time, HOUR_MODE);
+        return;
+    }
+#endif
+    
+    // 第一行显示日期
+    LCD_ShowNum(0, 0, 2000 + BCD_to_Decimal(Time[6]), 4);
+    LCD_ShowChar(0, 4, '-');
+    LCD_ShowNum(0, 5, BCD_to_Decimal(Time[4]), 2);
+    LCD_ShowChar(0, 7, '-');
+    LCD_ShowNum(0, 8, BCD_to_Decimal(Time[3]), 2);
+    LCD_ShowChar(0, 11, 'W');
+    LCD_ShowNum(0, 12, BCD_to_Decimal(Time[5]), 1);
+    
+#if FEATURE_CHIME
+    // 显示整点报时图标 (右上角显示一个 C 代表 Chime，或者空)
+    LCD_ShowChar(0, 15, hourly_chime ? 'C' : ' ');
+#endif
+
+    // 第二行显示时间 (核心逻辑)
+    h24 = BCD_to_Decimal(Time[2]); // 获取24小时制的十进制小时
+    
+    if(HOUR_MODE == 0) {
+        // --- 24小时制模式 ---
+        LCD_ShowNum(1, 0, h24, 2);
+        LCD_ShowChar(1, 2, ':');
+        LCD_ShowNum(1, 3, BCD_to_Decimal(Time[1]), 2);
+        LCD_ShowChar(1, 5, ':');
+        LCD_ShowNum(1, 6, BCD_to_Decimal(Time[0]), 2);
+        Text_Show(1, 9, TXT_BLANK, 7); // 清空后面的 AM/PM 区域
+    }
+#if FEATURE_12H
+    else {
+        // --- 12小时制模式 ---
+        // 计算 12 小时制数值
+        if(h24 == 0) h12 = 12;      // 0点是 12 AM
+        else if(h24 <= 12) h12 = h24; 
+        else h12 = h24 - 12;        // 13-23点 减12
+        
+        LCD_ShowNum(1, 0, h12, 2);
+        LCD_ShowChar(1, 2, ':');
+        LCD_ShowNum(1, 3, BCD_to_Decimal(Time[1]), 2);
+        LCD_ShowChar(1, 5, ':');
+        LCD_ShowNum(1, 6, BCD_to_Decimal(Time[0]), 2);
+        
+        // 显示 AM 或 PM
+        Text_Show(1, 9, h24 < 12 ? TXT_AM : TXT_PM, 3 | TEXT_RIGHT);
+    }
+#endif
+}
+
+// 闹钟显示界面
+void DisplayAlarm(void) {
+    LCD_ShowNum(0, 0, 2000 + BCD_to_Decimal(Time[6]), 4);
+    LCD_ShowChar(0, 4, '-');
+    LCD_ShowNum(0, 5, BCD_to_Decimal(Time[4]), 2);
+    LCD_ShowChar(0, 7, '-');
+    LCD_ShowNum(0, 8, BCD_to_Decimal(Time[3]), 2);
+    LCD_ShowChar(0, 13, 'W');
+    LCD_ShowNum(0, 14, BCD_to_Decimal(Time[5]), 1);
+    
+    Text_Show(1, 0, TXT_ALARM, 6);
+    LCD_ShowNum(1, 7, Alarm_Hour, 2);
+    LCD_ShowChar(1, 9, ':');
+    LCD_ShowNum(1, 10, Alarm_Min, 2);
+    if(alarm_triggered) {
+        Text_Show(1, 13, TXT_RING, 4);
+    } else {
+        Text_Show(1, 13, alarm_enabled ? TXT_ON : TXT_OFF, 3);
+    }
+}
+
+// 时间界面及其快捷键
+void Disp_TimeScreen(u8 key) {
+    DisplayTime();
+
+#if FEATURE_12H
+    // 按 K3 (UP) 切换 12/24 小时制
+    if(key == 3) {
+        hour_mode = !hour_mode; // 切换状态
+        DS1302_WriteRam(RAM_HOUR_MODE, hour_mode); // 立即保存
+        LCD_WriteCmd(0x01); // 清屏刷新
+    }
+#endif
+
+#if FEATURE_CHIME
+    // 按 K4 (DOWN) 切换整点报时
+    if(key == 4) Chime_Toggle();
+#endif
+
+#if FEATURE_BIGCLOCK
+    // 按 K2 (SEL) 切换大字显示
+    if(key == 2) {
+        big_digits = !big_digits;
+        LCD_WriteCmd(0x01);
+        if(big_digits) BigClock_Enter();
+    }
+#endif
+}
+
+// 闹钟界面及其快捷键
+void Disp_AlarmScreen(u8 key) {
+    DisplayAlarm();
+
+#if FEATURE_DEBUG_RING
+    // 方便调试：在闹钟显示界面按 KEY_UP (K3) 可以手动切换闹钟响铃状态
+    if(key == 3) Diag_DebugRing();
+#endif
+
+    // 在闹钟显示界面按 KEY_SEL (K2) 切换闹钟开关并持久保存
+    if(key == 2) {
+        alarm_enabled = !alarm_enabled;
+        // 持久化到 DS1302 的 RAM 3（RAM 0 是校验暗号，不能覆盖）
+        DS1302_WriteRam(RAM_ALARM_EN, alarm_enabled ? 0x01 : 0x00);
+        Text_Show(0, 0, alarm_enabled ? TXT_ALARM_ON : TXT_ALARM_OFF, 15);
+        DelayMs(800);
+        LCD_WriteCmd(0x01);
+    }
+}
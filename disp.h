@@ -0,0 +1,18 @@
+#ifndef __DISP_H__
+#define __DISP_H__
+
+#include "common.h"
+
+#if FEATURE_12H
+extern u8 xdata hour_mode;  // 0: 24 小时制, 1: 12 小时制 (DS1302 RAM 4)
+#endif
+#if FEATURE_BIGCLOCK
+extern u8 xdata big_digits; // 0: 文字时钟, 1: 大字
+#endif
+
+void DisplayTime(void);
+void DisplayAlarm(void);
+void Disp_TimeScreen(u8 key);   // MODE_TIME：显示 + K2/K3/K4 快捷键
+void Disp_AlarmScreen(u8 key);  // MODE_ALARM：显示 + K2 开关（K3 调试响铃）
+
+#endif
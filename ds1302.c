@@ -1,5 +1,6 @@
 #include "reg52.h"
 #include "ds1302.h"
+#include "timing.h"
 
 // =========================================================
 // ⚠警告：请务必确认以下引脚与你的开发板原理图一致！
@@ -9,22 +10,55 @@ sbit DS1302_CLK = P3^6;  // 对应你的 SCK
 sbit DS1302_IO  = P3^4;  // 对应你的 IO/DAT
 sbit DS1302_RST = P3^5;  // 对应你的 RST/CE
 
-// 简单的短延时，确保波形稳定
-void DS1302_Delay(void) {
-    unsigned char i;
-    for(i = 0; i < 2; i++); 
-}
+// DS1302 数据手册最小时序 (VCC = 5V，单位 ns)
+#define DS1302_T_DC     50      // 数据到 CLK 上升沿的建立时间
+#define DS1302_T_CL     250     // CLK 低电平宽度
+#define DS1302_T_CH     250     // CLK 高电平宽度
+#define DS1302_T_CDD    200     // CLK 下降沿到输出数据有效（最大值）
+#define DS1302_T_CC     1000    // CE 拉高到第一个 CLK 上升沿
+#define DS1302_T_CWH    1000    // 两次通信之间 CE 的最短低电平时间
+
+// =========================================================
+// 边沿时序自校准：走线长的板子在手册最小时序下可能读写出错，
+// 每个边沿在上面的手册最小延时之后再按级别附加一段 Timing_Spin。
+// 0 级 = 手册最小时序；DS1302_TRIM_SAFE = 最慢的保守时序。
+// 开机时在测试字节里写入/读回几组图案，从最慢逐级加快，选出能通过的级别，
+// 结果缓存在 RAM 里，热启动复测一次通过就直接用。
+// =========================================================
+#define DS1302_CAL_TAG      0xA0    // 缓存字节高 4 位标记，低 4 位 = 级别
+#define DS1302_TRIM_LEVELS  5
+#define DS1302_TRIM_SAFE    (DS1302_TRIM_LEVELS - 1)
+
+// 每级附加的 Timing_Spin 参数 (5 + 2n 个机器周期)，0 表示不附加
+static unsigned char code ds1302_trim_table[DS1302_TRIM_LEVELS] = { 0, 1, 2, 4, 8 };
+// 测试图案：交替位、高低半字节、全 0、全 1
+static unsigned char code ds1302_cal_pattern[] = { 0x55, 0xAA, 0x0F, 0xF0, 0x00, 0xFF };
+
+static unsigned char ds1302_trim = 8;                   // 当前附加的 Spin 参数，每个边沿都要用，放 DATA
+static unsigned char ds1302_level = DS1302_TRIM_SAFE;   // 当前级别，未校准前用最慢的
+
+#define DS1302_EDGE(ns) do {                        \
+        TIMING_EDGE_DELAY(ns);                      \
+        if(ds1302_trim) Timing_Spin(ds1302_trim);   \
+    } while(0)
+
+#if FEATURE_BUS_STATS
+unsigned int ds1302_bus_bytes = 0;  // 三线总线字节计数，用于总线流量统计
+#endif
 
 // 标准的单字节写入（上升沿写入）
 void DS1302_WriteByte(unsigned char dat) {
     unsigned char i;
+#if FEATURE_BUS_STATS
+    ds1302_bus_bytes++;
+#endif
     for(i = 0; i < 8; i++) {
         DS1302_IO = dat & 0x01; // 1. 先准备数据
-        DS1302_Delay();
+        DS1302_EDGE(DS1302_T_DC);
         DS1302_CLK = 1;         // 2. 拉高时钟（写入数据）
-        DS1302_Delay();
+        DS1302_EDGE(DS1302_T_CH);
         DS1302_CLK = 0;         // 3. 拉低时钟
-        DS1302_Delay();
+        DS1302_EDGE(DS1302_T_CL);
         dat >>= 1;              // 4. 移位
     }
 }
@@ -32,6 +66,9 @@ void DS1302_WriteByte(unsigned char dat) {
 // 标准的单字节读取（下降沿读取数据有效性）
 unsigned char DS1302_ReadByte(void) {
     unsigned char i, dat = 0;
+#if FEATURE_BUS_STATS
+    ds1302_bus_bytes++;
+#endif
     for(i = 0; i < 8; i++) {
         dat >>= 1;
         // DS1302 在时钟下降沿后输出数据，所以此时直接读取
@@ -41,9 +78,9 @@ unsigned char DS1302_ReadByte(void) {
         
         // 产生一个时钟脉冲，为下一位数据做准备
         DS1302_CLK = 1;
-        DS1302_Delay();
+        DS1302_EDGE(DS1302_T_CH);
         DS1302_CLK = 0;
-        DS1302_Delay();
+        DS1302_EDGE(DS1302_T_CDD); // 等数据稳定后再采样（同时满足 tCL）
     }
     return dat;
 }
@@ -52,7 +89,9 @@ unsigned char DS1302_ReadByte(void) {
 void DS1302_Write(unsigned char addr, unsigned char dat) {
     DS1302_RST = 0;
     DS1302_CLK = 0;
+    DS1302_EDGE(DS1302_T_CWH);
     DS1302_RST = 1; // 开启通信
+    DS1302_EDGE(DS1302_T_CC);
     
     DS1302_WriteByte(addr); // 写地址
     DS1302_WriteByte(dat);  // 写数据
@@ -65,7 +104,9 @@ unsigned char DS1302_Read(unsigned char addr) {
     unsigned char temp;
     DS1302_RST = 0;
     DS1302_CLK = 0;
+    DS1302_EDGE(DS1302_T_CWH);
     DS1302_RST = 1; // 开启通信
+    DS1302_EDGE(DS1302_T_CC);
     
     DS1302_WriteByte(addr); // 写地址
     temp = DS1302_ReadByte(); // 读数据
@@ -76,12 +117,69 @@ unsigned char DS1302_Read(unsigned char addr) {
     return temp;
 }
 
+static void DS1302_SetLevel(unsigned char level) {
+    ds1302_level = level;
+    ds1302_trim = ds1302_trim_table[level];
+}
+
+// 在当前级别下把每组图案写进测试字节再读回，全部一致返回 1（调用前需解除写保护）
+static unsigned char DS1302_TestLevel(void) {
+    unsigned char i;
+    for(i = 0; i < sizeof(ds1302_cal_pattern); i++) {
+        DS1302_Write(0xC0 + (DS1302_RAM_SCRATCH << 1), ds1302_cal_pattern[i]);
+        if(DS1302_Read(0xC1 + (DS1302_RAM_SCRATCH << 1)) != ds1302_cal_pattern[i]) return 0;
+    }
+    return 1;
+}
+
+// 选出能稳定读写的最快级别（调用前需解除写保护）
+static void DS1302_Calibrate(void) {
+    unsigned char level, cached;
+
+    DS1302_SetLevel(DS1302_TRIM_SAFE);
+    cached = DS1302_Read(0xC1 + (DS1302_RAM_CAL << 1));
+
+    // 热启动：上次的结果复测通过就直接用
+    if((cached & 0xF0) == DS1302_CAL_TAG && (cached & 0x0F) < DS1302_TRIM_LEVELS) {
+        DS1302_SetLevel(cached & 0x0F);
+        if(DS1302_TestLevel()) return;
+        DS1302_SetLevel(DS1302_TRIM_SAFE);
+    }
+
+    // 最慢都通不过：RTC 不在或坏了，保持保守时序，交给上层判断时间是否有效
+    if(!DS1302_TestLevel()) return;
+
+    // 从最慢逐级加快，直到读回出错；level 停在最后一个通过的级别
+    for(level = DS1302_TRIM_SAFE; level > 0; level--) {
+        DS1302_SetLevel(level - 1);
+        if(!DS1302_TestLevel()) break;
+    }
+    // 刚好通过的级别没有余量（温度、电压一变就可能出错），按配置再慢几级
+    level += DS1302_CAL_MARGIN;
+    if(level > DS1302_TRIM_SAFE) level = DS1302_TRIM_SAFE;
+    DS1302_SetLevel(level);
+
+    DS1302_Write(0xC0 + (DS1302_RAM_CAL << 1), DS1302_CAL_TAG | level);
+}
+
+// 运行中读回出错：退回保守时序，并作废缓存让下次开机重新校准。
+// 已经是保守时序时返回 0（重试也没用）
+static unsigned char DS1302_Fallback(void) {
+    if(ds1302_level == DS1302_TRIM_SAFE) return 0;
+    DS1302_SetLevel(DS1302_TRIM_SAFE);
+    DS1302_Write(0x8E, 0x00);
+    DS1302_Write(0xC0 + (DS1302_RAM_CAL << 1), 0x00);
+    DS1302_Write(0x8E, 0x80);
+    return 1;
+}
+
 // 初始化 DS1302 (解决时钟暂停问题)
 void DS1302_Init(void) {
     unsigned char sec;
     
-    // 1. 解除写保护
+    // 1. 解除写保护（此时还是保守时序），然后校准边沿时序
     DS1302_Write(0x8E, 0x00);
+    DS1302_Calibrate();
     
     // 2. 读取秒寄存器，检查是否处于 Halt (暂停) 状态
     sec = DS1302_Read(0x81);
@@ -95,13 +193,17 @@ void DS1302_Init(void) {
 
 // 读取时间到数组
 void DS1302_ReadTime(unsigned char *t) {
-    t[0] = DS1302_Read(0x81); // 秒
-    t[1] = DS1302_Read(0x83); // 分
-    t[2] = DS1302_Read(0x85); // 时
-    t[3] = DS1302_Read(0x87); // 日
-    t[4] = DS1302_Read(0x89); // 月
-    t[5] = DS1302_Read(0x8B); // 周
-    t[6] = DS1302_Read(0x8D); // 年
+    do {
+        t[0] = DS1302_Read(0x81); // 秒
+        t[1] = DS1302_Read(0x83); // 分
+        t[2] = DS1302_Read(0x85); // 时
+        t[3] = DS1302_Read(0x87); // 日
+        t[4] = DS1302_Read(0x89); // 月
+        t[5] = DS1302_Read(0x8B); // 周
+        t[6] = DS1302_Read(0x8D); // 年
+        // 秒不是合法 BCD（典型是 0xFF：采样早于数据有效）说明当前时序不可靠，
+        // 退回保守时序重读；已经是保守时序就原样交给上层判断
+    } while(((t[0] & 0x0F) > 9 || (t[0] & 0x70) > 0x50) && DS1302_Fallback());
 }
 
 // 设置时间
@@ -119,14 +221,82 @@ void DS1302_SetTime(unsigned char *t) {
     DS1302_Write(0x8E, 0x80); // 打开写保护
 }
 
+// RAM 没有格式可以检查，连读两次比较；不一致就退回保守时序重读
 unsigned char DS1302_ReadRam(unsigned char ram_index) {
-    unsigned char addr = 0xC0 + (ram_index << 1);
-    return DS1302_Read(addr | 0x01);
+    unsigned char addr = 0xC1 + (ram_index << 1);
+    unsigned char dat;
+    do {
+        dat = DS1302_Read(addr);
+    } while(DS1302_Read(addr) != dat && DS1302_Fallback());
+    return dat;
 }
 
 void DS1302_WriteRam(unsigned char ram_index, unsigned char dat) {
     unsigned char addr = 0xC0 + (ram_index << 1);
     DS1302_Write(0x8E, 0x00);
     DS1302_Write(addr, dat);
+    // 读回校验，不一致就退回保守时序再写一次
+    if(DS1302_Read(addr | 0x01) != dat && DS1302_Fallback()) {
+        DS1302_Write(0x8E, 0x00);
+        DS1302_Write(addr, dat);
+    }
+    DS1302_Write(0x8E, 0x80);
+}
+
+// 一次 RAM 突发读（1 次通信，len <= 31）。verify = 0 时读进 buf；
+// verify = 1 时不改 buf，只和 buf 逐字节比较，有不一致返回 1
+static unsigned char DS1302_BurstIn(unsigned char *buf, unsigned char len, unsigned char verify) {
+    unsigned char i, dat, diff = 0;
+    DS1302_RST = 0;
+    DS1302_CLK = 0;
+    DS1302_EDGE(DS1302_T_CWH);
+    DS1302_RST = 1;
+    DS1302_EDGE(DS1302_T_CC);
+
+    DS1302_WriteByte(0xFF);
+    for(i = 0; i < len; i++) {
+        dat = DS1302_ReadByte();
+        if(!verify) buf[i] = dat;
+        else if(dat != buf[i]) diff = 1;
+    }
+
+    DS1302_RST = 0;
+    DS1302_CLK = 0;
+    return diff;
+}
+
+// 一次 RAM 突发写（需先解除写保护）
+static void DS1302_BurstOut(unsigned char *buf, unsigned char len) {
+    unsigned char i;
+    DS1302_RST = 0;
+    DS1302_CLK = 0;
+    DS1302_EDGE(DS1302_T_CWH);
+    DS1302_RST = 1;
+    DS1302_EDGE(DS1302_T_CC);
+
+    DS1302_WriteByte(0xFE);
+    for(i = 0; i < len; i++) DS1302_WriteByte(buf[i]);
+
+    DS1302_RST = 0;
+}
+
+// RAM 突发读：从 RAM 0 开始连续读 len 个字节。
+// 和 ReadRam 一样再读一遍比较，不一致就退回保守时序重读
+void DS1302_ReadRamBurst(unsigned char *buf, unsigned char len) {
+    DS1302_BurstIn(buf, len, 0);
+    while(DS1302_BurstIn(buf, len, 1) && DS1302_Fallback()) {
+        DS1302_BurstIn(buf, len, 0);
+    }
+}
+
+// RAM 突发写：从 RAM 0 开始连续写 len 个字节，提前结束时只更新已写的字节。
+// 写完突发读回校验，不一致就退回保守时序再写一次
+void DS1302_WriteRamBurst(unsigned char *buf, unsigned char len) {
+    DS1302_Write(0x8E, 0x00);
+    DS1302_BurstOut(buf, len);
+    if(DS1302_BurstIn(buf, len, 1) && DS1302_Fallback()) {
+        DS1302_Write(0x8E, 0x00);
+        DS1302_BurstOut(buf, len);
+    }
     DS1302_Write(0x8E, 0x80);
 }
\ No newline at end of file
@@ -11,5 +11,15 @@ void DS1302_ReadTime(unsigned char *t);
 // Read/Write DS1302 RAM (ram index 0..30)
 unsigned char DS1302_ReadRam(unsigned char ram_index);
 void DS1302_WriteRam(unsigned char ram_index, unsigned char dat);
+// RAM 29..30 belong to the driver: calibrated edge timing cache and test byte
+#define DS1302_RAM_CAL      29
+#define DS1302_RAM_SCRATCH  30
+// Burst access always starts at RAM 0; len may stop short of 31
+void DS1302_ReadRamBurst(unsigned char *buf, unsigned char len);
+void DS1302_WriteRamBurst(unsigned char *buf, unsigned char len);
+
+#if FEATURE_BUS_STATS
+extern unsigned int ds1302_bus_bytes;   // bytes shifted on the 3-wire bus since reset
+#endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,304 @@
+#include "app.h"
+#include "editor.h"
+#include "alarm.h"
+#include "lcd1602.h"
+#include "ds1302.h"
+#include "calendar.h"
+#include "timing.h"
+#include "eventlog.h"
+#include "text.h"
+#include "softclock.h"
+
+// =========================================================
+// 设置界面：闹钟时间 (MODE_SET_ALARM) 与系统时间 (MODE_SET_TIME)
+// =========================================================
+
+static u8 xdata set_time_index = 0; // 时间设置项索引
+static u8 xdata alarm_edit_pos = 0; // 0:编辑小时, 1:编辑分钟
+
+// 设置闹钟界面
+static void DisplaySetAlarm(void) {
+    Text_Show(0, 0, TXT_SET_ALARM, 16);
+    
+    if(alarm_edit_pos == 0) {
+        LCD_ShowChar(1, 0, '>');
+        LCD_ShowNum(1, 2, Alarm_Hour, 2);
+        LCD_ShowChar(1, 4, ':');
+        LCD_ShowNum(1, 6, Alarm_Min, 2);
+        Text_Show(1, 9, TXT_HOUR, 6);
+    } else {
+        LCD_ShowChar(1, 0, ' ');
+        LCD_ShowNum(1, 2, Alarm_Hour, 2);
+        LCD_ShowChar(1, 4, ':');
+        LCD_ShowChar(1, 6, '>');
+        LCD_ShowNum(1, 7, Alarm_Min, 2);
+        Text_Show(1, 9, TXT_MINUTE, 6);
+    }
+}
+
+// 设置时间界面
+static void DisplaySetTime(void) {
+    u8 hour, min, day, month, year, week;
+    
+    if(setting_mode) {
+        hour = BCD_to_Decimal(Temp_Time[2]);
+        min = BCD_to_Decimal(Temp_Time[1]);
+        day = BCD_to_Decimal(Temp_Time[3]);
+        month = BCD_to_Decimal(Temp_Time[4]);
+        year = BCD_to_Decimal(Temp_Time[6]);  // 使用 Temp_Time 里的年份 (t[6]=year)
+        week = BCD_to_Decimal(Temp_Time[5]); // 星期在 t[5]
+    } else {
+        hour = BCD_to_Decimal(Time[2]);
+        min = BCD_to_Decimal(Time[1]);
+        day = BCD_to_Decimal(Time[3]);
+        month = BCD_to_Decimal(Time[4]);
+        year = BCD_to_Decimal(Time[6]);  // 使用 Time 里的年份 (t[6]=year)
+        week = BCD_to_Decimal(Time[5]);
+    }
+    
+    Text_Show(0, 0, TXT_SET_TIME, 16);
+    
+    switch(set_time_index) {
+        case 0: // 年
+            Text_Show(1, 0, TXT_ED_YEAR, 9);
+            LCD_ShowNum(1, 9, year, 2);  // 显示修改后的年份
+            Text_Show(1, 11, TXT_BLANK, 5);
+            break;
+        case 1: // 月
+            Text_Show(1, 0, TXT_ED_MONTH, 9);
+            LCD_ShowNum(1, 8, month, 2);
+            Text_Show(1, 10, TXT_BLANK, 5);
+            break;
+        case 2: // 日（星期由年月日自动推算，仅供核对）
+            Text_Show(1, 0, TXT_ED_DAY, 9);
+            LCD_ShowNum(1, 8, day, 2);
+            Text_Show(1, 10, TXT_WEEK, 3 | TEXT_RIGHT);
+            LCD_ShowNum(1, 13, week, 1);
+            LCD_ShowChar(1, 14, ' ');
+            break;
+        case 3: // 时
+            Text_Show(1, 0, TXT_ED_HOUR, 9);
+            LCD_ShowNum(1, 8, hour, 2);
+            Text_Show(1, 10, TXT_BLANK, 5);
+            break;
+        case 4: // 分
+            Text_Show(1, 0, TXT_ED_MINUTE, 9);
+            LCD_ShowNum(1, 8, min, 2);
+            Text_Show(1, 10, TXT_BLANK, 5);
+            break;
+    }
+}
+
+void Editor_SetAlarm(u8 key) {
+    if(!setting_mode) {
+        DisplaySetAlarm();
+        if(key == 1) {
+            setting_mode = 1;
+            alarm_edit_pos = 0;
+            LCD_WriteCmd(0x01);
+        }
+    } else {
+        DisplaySetAlarm();
+        
+        if(key == 2) {
+            alarm_edit_pos = !alarm_edit_pos;
+            DelayMs(200);
+        }
+        
+        if(key == 3) {
+            if(alarm_edit_pos == 0) {
+                Alarm_Hour++;
+                if(Alarm_Hour >= 24) Alarm_Hour = 0;
+            } else {
+                Alarm_Min++;
+                if(Alarm_Min >= 60) Alarm_Min = 0;
+            }
+            if(!fast_mode) DelayMs(200);
+        }
+        
+        if(key == 4) {
+            if(alarm_edit_pos == 0) {
+                if(Alarm_Hour == 0) Alarm_Hour = 23;
+                else Alarm_Hour--;
+            } else {
+                if(Alarm_Min == 0) Alarm_Min = 59;
+                else Alarm_Min--;
+            }
+            if(!fast_mode) DelayMs(200);
+        }
+        
+        if(key == 1) {
+            DS1302_WriteRam(RAM_ALARM_H, Alarm_Hour);
+            DS1302_WriteRam(RAM_ALARM_M, Alarm_Min);
+            DS1302_WriteRam(RAM_ALARM_EN, alarm_enabled);
+            setting_mode = 0;
+            Text_Show(0, 0, TXT_ALARM_SAVED, 16);
+            Text_Show(1, 0, TXT_BLANK, 16);
+            DelayMs(1000);
+            LCD_WriteCmd(0x01);
+        }
+    }
+}
+
+void Editor_SetTime(u8 key) {
+    u8 i;
+
+    if(!setting_mode) {
+        DisplaySetTime();
+        if(key == 1) {
+            setting_mode = 1;
+            set_time_index = 0;
+            // 保存当前时间到 Temp_Time 数组
+            for(i = 0; i < 7; i++) {
+                Temp_Time[i] = Time[i];
+            }
+            LCD_WriteCmd(0x01);
+        }
+    } else {
+        DisplaySetTime();
+        
+        if(key == 2) {
+            set_time_index++;
+            if(set_time_index > 4) set_time_index = 0; // 星期自动推算，不再手动设置
+            DelayMs(200);
+        }
+        
+        if(key == 3) {
+            switch(set_time_index) {
+                case 0: // 年
+                        {
+                            u8 v = BCD_to_Decimal(Temp_Time[6]);
+                            v++;
+                            if(v > 99) v = 0;
+                            Temp_Time[6] = Decimal_to_BCD(v);
+                        }
+                    break;
+                case 1: // 月
+                        {
+                            u8 v = BCD_to_Decimal(Temp_Time[4]);
+                            v++;
+                            if(v > 12) v = 1;
+                            Temp_Time[4] = Decimal_to_BCD(v);
+                        }
+                    break;
+                case 2: // 日
+                        {
+                            u8 v = BCD_to_Decimal(Temp_Time[3]);
+                            v++;
+                            if(v > Cal_DaysInMonth(BCD_to_Decimal(Temp_Time[6]), BCD_to_Decimal(Temp_Time[4]))) v = 1;
+                            Temp_Time[3] = Decimal_to_BCD(v);
+                        }
+                    break;
+                case 3: // 时
+                        {
+                            u8 v = BCD_to_Decimal(Temp_Time[2]);
+                            v++;
+                            if(v >= 24) v = 0;
+                            Temp_Time[2] = Decimal_to_BCD(v);
+                        }
+                    break;
+                case 4: // 分
+                        {
+                            u8 v = BCD_to_Decimal(Temp_Time[1]);
+                            v++;
+                            if(v >= 60) v = 0;
+                            Temp_Time[1] = Decimal_to_BCD(v);
+                        }
+                    break;
+            }
+            // 改年/月后日期可能越界（如 3-31 改成 2 月），同时刷新星期
+            Cal_Normalize(Temp_Time);
+            if(!fast_mode) DelayMs(200);
+        }
+        
+        if(key == 4) {
+            switch(set_time_index) {
+                case 0: // 年
+                        {
+                            u8 v = BCD_to_Decimal(Temp_Time[6]);
+                            if(v == 0) v = 99;
+                            else v--;
+                            Temp_Time[6] = Decimal_to_BCD(v);
+                        }
+                    break;
+                case 1: // 月
+                        {
+                            u8 v = BCD_to_Decimal(Temp_Time[4]);
+                            if(v == 1) v = 12;
+                            else v--;
+                            Temp_Time[4] = Decimal_to_BCD(v);
+                        }
+                    break;
+                case 2: // 日
+                        {
+                            u8 v = BCD_to_Decimal(Temp_Time[3]);
+                            if(v == 1) v = Cal_DaysInMonth(BCD_to_Decimal(Temp_Time[6]), BCD_to_Decimal(Temp_Time[4]));
+                            else v--;
+                            Temp_Time[3] = Decimal_to_BCD(v);
+                        }
+                    break;
+                case 3: // 时
+                        {
+                            u8 v = BCD_to_Decimal(Temp_Time[2]);
+                            if(v == 0) v = 23;
+                            else v--;
+                            Temp_Time[2] = Decimal_to_BCD(v);
+                        }
+                    break;
+                case 4: // 分
+                        {
+                            u8 v = BCD_to_Decimal(Temp_Time[1]);
+                            if(v == 0) v = 59;
+                            else v--;
+                            Temp_Time[1] = Decimal_to_BCD(v);
+                        }
+                    break;
+            }
+            Cal_Normalize(Temp_Time);
+            if(!fast_mode) DelayMs(200);
+        }
+        
+        if(key == 1) {
+            setting_mode = 0;
+            set_time_index = 0;
+            // 在写入 RTC 前校验（含大小月/闰年），防止未初始化或非法数据写入
+            {
+                Cal_Normalize(Temp_Time);
+                if(!Cal_IsTimeValid(Temp_Time)) {
+                    Text_Show(0, 0, TXT_INVALID_TIME, 16);
+                    Text_Show(1, 0, TXT_SAVE_ABORTED, 16);
+                    DelayMs(1000);
+                    LCD_WriteCmd(0x01);
+                    // 不写入 RTC，恢复显示
+                    // 更新 Time 数组以保证界面同步
+                    for(i = 0; i < 7; i++) {
+                        Time[i] = Temp_Time[i];
+                    }
+                    return;
+                }
+            }
+            // 保存时间到 DS1302（通过校验后写入）
+            // 将秒归零以避免未设置的秒导致写入后显示异常
+            Temp_Time[0] = Decimal_to_BCD(0);
+            DS1302_SetTime(Temp_Time); // 写入 RTC
+            // 给 RTC 少许时间稳定，然后读回确认并刷新显示数据
+            DelayMs(200);
+            DS1302_ReadTime(Time);
+            // 如果读回值仍然非法，则退回使用刚保存的 Temp_Time
+            if(!Cal_IsTimeValid(Time)) {
+                for(i = 0; i < 7; i++) {
+                    Time[i] = Temp_Time[i];
+                }
+            }
+            // 软件时钟从刚保存的时间重新走；RTC 仍然异常的话下次对时会再标记降级
+            SoftClock_Set(Time);
+            EventLog_Append(EV_TIME_SET, 0, Time);
+            // 保存完成后立即切换到时间显示页面并恢复正常运行
+            mode = MODE_TIME;      // 切换到显示时间模式
+            Text_Show(0, 0, TXT_TIME_SAVED, 16);
+            Text_Show(1, 0, TXT_BLANK, 16);
+            DelayMs(1000);
+            LCD_WriteCmd(0x01);
+        }
+    }
+}
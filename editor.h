@@ -0,0 +1,9 @@
+#ifndef __EDITOR_H__
+#define __EDITOR_H__
+
+#include "common.h"
+
+void Editor_SetAlarm(u8 key);   // MODE_SET_ALARM
+void Editor_SetTime(u8 key);    // MODE_SET_TIME
+
+#endif
@@ -0,0 +1,131 @@
+#include "app.h"
+#include "eventlog.h"
+#include "ds1302.h"
+#include "calendar.h"
+#include "softclock.h"
+
+#if FEATURE_EVENTLOG
+
+// =========================================================
+// 事件日志放在 DS1302 RAM 里（有电池就不会丢）：
+//   RAM 6      : 头部，高 4 位 = 有效条数，低 4 位 = 下一条写入的槽位
+//   RAM 7..26  : 5 条记录，每条 4 字节，写满后从头覆盖
+//   RAM 27..28 : 保留（29..30 归 ds1302.c 的时序校准使用）
+// 写入时先突发读 RAM 0..26（驱动再读一遍校验），改好头部和记录后突发写回
+// （驱动读回校验），共四次突发。RAM 0..5 的设置按读到的原样写回，
+// 编辑器里还没确认的闹钟设置不会被顺带存进去。RTC 不可信（软件时钟降级）时
+// 不碰 DS1302，记录先在 XRAM 里排队，RTC 恢复后由 EventLog_Flush 一起写入。
+// 连续的开机记录合并成一条，arg 记开机次数，免得几次复位就把日志挤满。
+// =========================================================
+#define EVLOG_RAM_HEAD      6
+#define EVLOG_RAM_FIRST     7
+#define EVLOG_RAM_END       (EVLOG_RAM_FIRST + EVLOG_ENTRIES * EVLOG_ENTRY_SIZE)
+
+static u8 xdata evlog_pending[EVLOG_ENTRIES][EVLOG_ENTRY_SIZE];  // 待写入的记录，最旧的在前
+static u8 xdata evlog_pending_n = 0;
+
+#if FEATURE_HISTORY
+static u8 EventLog_Head(void) {
+    u8 head = DS1302_ReadRam(EVLOG_RAM_HEAD);
+    // 新电池或 RAM 乱码时当作空日志
+    if((head >> 4) > EVLOG_ENTRIES || (head & 0x0F) >= EVLOG_ENTRIES) return 0;
+    return head;
+}
+
+#endif
+
+void EventLog_Reset(void) {
+    DS1302_WriteRam(EVLOG_RAM_HEAD, 0);
+}
+
+// 把排队的记录一起写入 DS1302 RAM
+void EventLog_Flush(void) {
+    u8 xdata ram[EVLOG_RAM_END];
+    u8 xdata *e;
+    u8 xdata *last;
+    u8 head, slot, count, boots, i, j;
+
+    if(!evlog_pending_n || soft_degraded) return;
+
+    DS1302_ReadRamBurst(ram, EVLOG_RAM_END);
+
+    head = ram[EVLOG_RAM_HEAD];
+    if((head >> 4) > EVLOG_ENTRIES || (head & 0x0F) >= EVLOG_ENTRIES) head = 0;
+    slot = head & 0x0F;
+    count = head >> 4;
+
+    for(i = 0; i < evlog_pending_n; i++) {
+        e = evlog_pending[i];
+        last = ram + EVLOG_RAM_FIRST + (slot ? slot - 1 : EVLOG_ENTRIES - 1) * EVLOG_ENTRY_SIZE;
+        if(EVLOG_CODE(e) == EV_POWER_ON && count && EVLOG_CODE(last) == EV_POWER_ON) {
+            // 上一条也是开机：改成这次的时间，次数加 1
+            boots = EVLOG_ARG(last);
+            for(j = 0; j < EVLOG_ENTRY_SIZE; j++) last[j] = e[j];
+            last[3] = (boots < 255) ? boots + 1 : 255;
+            continue;
+        }
+        for(j = 0; j < EVLOG_ENTRY_SIZE; j++) {
+            ram[EVLOG_RAM_FIRST + slot * EVLOG_ENTRY_SIZE + j] = e[j];
+        }
+        if(count < EVLOG_ENTRIES) count++;
+        slot++;
+        if(slot >= EVLOG_ENTRIES) slot = 0;
+    }
+    ram[EVLOG_RAM_HEAD] = (count << 4) | slot;
+    evlog_pending_n = 0;
+
+    DS1302_WriteRamBurst(ram, EVLOG_RAM_END);
+}
+
+void EventLog_Append(u8 ev, u8 arg, u8 *t) {
+    u8 i, j, month = 0, day = 0;
+    u16 mod = 0;
+    u8 xdata *e;
+
+    if(t) {
+        month = BCD_to_Decimal(t[4]);
+        day = BCD_to_Decimal(t[3]);
+        mod = Cal_MinuteOfDay(t);
+    }
+
+    // 队列满了（RTC 长时间不可信）丢掉最旧的一条，和 RAM 里的环形覆盖一致
+    if(evlog_pending_n >= EVLOG_ENTRIES) {
+        for(i = 1; i < EVLOG_ENTRIES; i++) {
+            for(j = 0; j < EVLOG_ENTRY_SIZE; j++) evlog_pending[i - 1][j] = evlog_pending[i][j];
+        }
+        evlog_pending_n--;
+    }
+
+    e = evlog_pending[evlog_pending_n++];
+    e[0] = (ev << 4) | (month & 0x0F);
+    e[1] = ((u8)(mod >> 8) << 5) | (day & 0x1F);
+    e[2] = (u8)mod;
+    e[3] = arg;
+
+    EventLog_Flush();
+}
+
+#if FEATURE_HISTORY
+u8 EventLog_Count(void) {
+    return EventLog_Head() >> 4;
+}
+
+u8 EventLog_Get(u8 n, u8 *entry) {
+    u8 head = EventLog_Head();
+    u8 slot, i, ram_index;
+
+    if(n >= (head >> 4)) return 0;
+
+    // 最新一条在 “下一槽位 - 1”，往前数 n 条
+    slot = (head & 0x0F) + EVLOG_ENTRIES - 1 - n;
+    if(slot >= EVLOG_ENTRIES) slot -= EVLOG_ENTRIES;
+
+    ram_index = EVLOG_RAM_FIRST + slot * EVLOG_ENTRY_SIZE;
+    for(i = 0; i < EVLOG_ENTRY_SIZE; i++) {
+        entry[i] = DS1302_ReadRam(ram_index + i);
+    }
+    return 1;
+}
+#endif
+
+#endif
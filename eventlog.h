@@ -0,0 +1,42 @@
+#ifndef __EVENTLOG_H__
+#define __EVENTLOG_H__
+
+#include "common.h"
+
+// 事件代码（记录第 0 字节的高 4 位）
+#define EV_NONE             0
+#define EV_POWER_ON         1   // arg = 连续开机次数（相邻的开机记录合并）
+#define EV_RTC_INVALID      2   // 上电时 RTC 时间无效
+#define EV_TIME_SET         3
+#define EV_ALARM_FIRED      4   // arg = 晚了几秒
+#define EV_ALARM_DISMISSED  5   // arg = 响了几秒
+#define EV_ALARM_AUTOSTOP   6   // arg = 响了几秒
+
+#define EVLOG_ENTRIES       5   // DS1302 RAM 里保存的条数
+#define EVLOG_ENTRY_SIZE    4
+
+// 每条记录 4 字节：
+//   [0] 代码 << 4 | 月          [1] (当天分钟数 >> 8) << 5 | 日
+//   [2] 当天分钟数 & 0xFF       [3] arg
+#define EVLOG_CODE(e)       ((e)[0] >> 4)
+#define EVLOG_MONTH(e)      ((e)[0] & 0x0F)
+#define EVLOG_DAY(e)        ((e)[1] & 0x1F)
+#define EVLOG_MINUTE(e)     ((((u16)(e)[1] >> 5) << 8) | (e)[2])
+#define EVLOG_ARG(e)        ((e)[3])
+
+#if FEATURE_EVENTLOG
+void EventLog_Reset(void);
+void EventLog_Append(u8 ev, u8 arg, u8 *t);     // t = BCD 时间，0 = 时间未知
+void EventLog_Flush(void);                      // RTC 恢复后写入排队的记录
+#else
+#define EventLog_Reset()
+#define EventLog_Append(ev, arg, t)
+#define EventLog_Flush()
+#endif
+
+#if FEATURE_HISTORY
+u8 EventLog_Count(void);
+u8 EventLog_Get(u8 n, u8 *entry);               // n = 0 为最新一条；不存在时返回 0
+#endif
+
+#endif
@@ -1,5 +1,6 @@
 #include "reg52.h"
 #include "lcd1602.h"
+#include "timing.h"
 #include <math.h>  // ѧͷļ
 
 sbit RS = P2^6;
@@ -7,25 +8,100 @@ sbit RW = P2^5;
 sbit EN = P2^7;
 #define LCD_PORT P0
 
-void DelayUs(unsigned int us){ while(us--); }
+// HD44780 ֲСʱ򣨵λ ns / usȡ¾ɰ汾нϱصֵ
+#define LCD_T_AS        140     // RS/RW  EN صĽʱ (ns)
+#define LCD_T_PW        450     // EN ߵƽ (ns)
+#define LCD_T_EXEC      40      // һָ/дִʱ (us)ֲֵ 37us
+#define LCD_T_CLEAR     1640    // /λִʱ (us)ֲ 1.52ms
+#define LCD_T_POWER_ON  15      // ϵ絽һָ (ms)
+
+// =========================================================
+// 첽дУֻֽڷŽλ壬 Timer0 жÿʱ϶һֽڡ
+// ʱ϶ >= ִָʱ䣬ԲҪæ־/λ֮󵥶һʱ϶
+// Timer0 ֻڶзǿʱУʱռ CPU
+// =========================================================
+#define LCD_QUEUE_SIZE  64      //  2 ݣһ + ַ
+#define LCD_SLOT_US     100     // ÿֽʱ϶ (us) >= LCD_T_EXEC
+
+#define LCD_SLOT_RELOAD   (65536UL - TIMING_US_TO_CYCLES(LCD_SLOT_US))
+#define LCD_CLEAR_RELOAD  (65536UL - TIMING_US_TO_CYCLES(LCD_T_CLEAR))
+
+typedef char LCD_SLOT_CHECK[(LCD_SLOT_US >= LCD_T_EXEC) ? 1 : -1];
+
+static unsigned char xdata lcd_q_dat[LCD_QUEUE_SIZE];  // Ƭ XRAMʡ IRAM ջ
+static unsigned char idata lcd_q_rs[LCD_QUEUE_SIZE / 8];   // ÿ 1 λ1= 0=
+static volatile unsigned char lcd_q_head = 0;   // ѭдλ
+static volatile unsigned char lcd_q_tail = 0;   // ж϶ȡλãLCD_Put ʱҪ¶
+unsigned char lcd_clear_seq = 0;        // ÿ 1
+#if FEATURE_BUS_STATS
+unsigned int lcd_bus_bytes = 0;         // ֽڼԤ
+#endif
+
+static unsigned char code lcd_bit_mask[8] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+
+// һֽڣʱжȡһֻһдһʱ
+static void LCD_Put(unsigned char rs, unsigned char dat){
+    unsigned char head = lcd_q_head;
+    unsigned char next = (head + 1) & (LCD_QUEUE_SIZE - 1);
+
+    while(next == lcd_q_tail);
+
+    lcd_q_dat[head] = dat;
+    if(rs) lcd_q_rs[head >> 3] |= lcd_bit_mask[head & 7];
+    else   lcd_q_rs[head >> 3] &= ~lcd_bit_mask[head & 7];
+    lcd_q_head = next;      // дƶ headжϿһһ
+    TR0 = 1;
+#if FEATURE_BUS_STATS
+    lcd_bus_bytes++;
+#endif
+}
+
+// Timer0ÿʱ϶Ѷֽ͵ LCDп˾ͣ
+void LCD_Isr(void) interrupt 1 {
+    unsigned char tail = lcd_q_tail;
+    unsigned char dat, rs;
+
+    if(tail == lcd_q_head) {
+        TR0 = 0;
+        TH0 = LCD_SLOT_RELOAD >> 8;
+        TL0 = LCD_SLOT_RELOAD & 0xFF;
+        return;
+    }
+
+    dat = lcd_q_dat[tail];
+    rs = lcd_q_rs[tail >> 3] & lcd_bit_mask[tail & 7];
+
+    RS = rs ? 1 : 0;
+    RW = 0;
+    LCD_PORT = dat;
+    TIMING_EDGE_DELAY(LCD_T_AS);
+    EN = 1;
+    TIMING_EDGE_DELAY(LCD_T_PW);
+    EN = 0;
 
-void LCD_WriteCmd(unsigned char cmd){
-    RS=0; RW=0; LCD_PORT=cmd; EN=1; 
-    DelayUs(50); 
-    EN=0;
-    
-    // ָһ
     // 0x01 0x02 ǹλر
-    if(cmd == 0x01 || cmd == 0x02) {
-        // Ҫһ뼶ʱ lcd1602.c ֻ DelayUs
-        // Լ򵥵صö DelayUsֱѭ
-        unsigned int i = 2000; 
-        while(i--); // ǿʱԼ 2ms
+    if(!rs && (dat == 0x01 || dat == 0x02)) {
+        TH0 = LCD_CLEAR_RELOAD >> 8;
+        TL0 = LCD_CLEAR_RELOAD & 0xFF;
+    } else {
+        TH0 = LCD_SLOT_RELOAD >> 8;
+        TL0 = LCD_SLOT_RELOAD & 0xFF;
     }
+    lcd_q_tail = (tail + 1) & (LCD_QUEUE_SIZE - 1);
+}
+
+void LCD_WriteCmd(unsigned char cmd){
+    if(cmd == 0x01) lcd_clear_seq++;
+    LCD_Put(0, cmd);
 }
 
 void LCD_WriteData(unsigned char dat){
-    RS=1; RW=0; LCD_PORT=dat; EN=1; DelayUs(50); EN=0;
+    LCD_Put(1, dat);
+}
+
+// ȴȫϣһֽڵִʱ䣩
+void LCD_Flush(void){
+    while(TR0);
 }
 
 void LCD_ShowString(unsigned char row, unsigned char col, char *str){
@@ -35,6 +111,19 @@ void LCD_ShowString(unsigned char row, unsigned char col, char *str){
     while(*str) LCD_WriteData(*str++);
 }
 
+// ַռóַ
+void LCD_ShowChar(unsigned char row, unsigned char col, char ch){
+    LCD_WriteCmd(0x80 | ((row ? 0x40 : 0x00) + col));
+    LCD_WriteData(ch);
+}
+
+// дһԶַ CGRAMslot 0..78 еÿе 5 λЧ
+void LCD_SetGlyph(unsigned char slot, unsigned char code *pattern){
+    unsigned char i;
+    LCD_WriteCmd(0x40 | (slot << 3));
+    for(i = 0; i < 8; i++) LCD_WriteData(pattern[i]);
+}
+
 void LCD_ShowNum(unsigned char row, unsigned char col, unsigned int num, unsigned char len){
     unsigned char i;
     char buffer[6];  // ̶СĻ
@@ -55,8 +144,19 @@ void LCD_ShowNum(unsigned char row, unsigned char col, unsigned int num, unsigne
 
 
 void LCD_Init(void){
+    // λ P2 ȫΪߣEN ҲǸߣ֮ͣ RS/RW ֻ EN ͵ƽʱı
+    EN = 0;
+    DelayMs(LCD_T_POWER_ON);        //  LCD ϵڲλ
+
+    TMOD = (TMOD & 0xF0) | 0x01;    // Timer0 ģʽ116 λװֵжд
+    TH0 = LCD_SLOT_RELOAD >> 8;
+    TL0 = LCD_SLOT_RELOAD & 0xFF;
+    ET0 = 1;
+    EA = 1;
+
     LCD_WriteCmd(0x38);
     LCD_WriteCmd(0x0C);
     LCD_WriteCmd(0x06);
     LCD_WriteCmd(0x01);
+    LCD_Flush();
 }
\ No newline at end of file
@@ -5,7 +5,18 @@
 void LCD_Init(void);
 void LCD_WriteCmd(unsigned char cmd);
 void LCD_WriteData(unsigned char dat);
+void LCD_Flush(void);   // 等待异步写队列发送完毕
 void LCD_ShowString(unsigned char row, unsigned char col, char *str);
+void LCD_ShowChar(unsigned char row, unsigned char col, char ch);
 void LCD_ShowNum(unsigned char row, unsigned char col, unsigned int num, unsigned char len);
+// 把一个 5x8 自定义字符写入 CGRAM 槽 0..7
+void LCD_SetGlyph(unsigned char slot, unsigned char code *pattern);
+
+// 每次清屏 (0x01) 加 1；缓存了屏幕内容的模块比较它，判断是否要全部重画
+extern unsigned char lcd_clear_seq;
+
+#if FEATURE_BUS_STATS
+extern unsigned int lcd_bus_bytes;  // 上电以来送入 LCD 队列的字节数
+#endif
 
 #endif
\ No newline at end of file
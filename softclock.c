@@ -0,0 +1,247 @@
+#include "reg52.h"
+#include "softclock.h"
+#include "ds1302.h"
+#include "calendar.h"
+#include "timing.h"
+#include "eventlog.h"
+
+// =========================================================
+// 软件时钟：Timer2 每秒中断 SOFTCLOCK_TICKS_PER_S 次，中断里只数秒；
+// 主循环把累计的秒数加到 BCD 时间上，所以显示不再每轮都读 DS1302。
+// 每 SOFTCLOCK_RESYNC_S 秒和每个整分钟与 DS1302 对一次时：
+//   差 1 秒以内不动（两边秒边界的相位差）；
+//   软件时钟慢了直接跳到 RTC 时间，快了就停几秒等 RTC 追上（时间不倒退）。
+// 对时时累计软件时钟相对 RTC 的快慢，统计够长、偏差够大后修正 Timer2 重装值。
+// RTC 读回非法、时钟暂停或者不再走时，就只靠软件时钟运行并标记降级。
+// =========================================================
+#define SOFTCLOCK_TRIM_MAX      1000    // 重装值最多修正 ±1000 个周期
+#define SOFTCLOCK_JUMP_S        60      // 差得比这还多说明有人改过 RTC，不计入快慢统计
+
+// 一拍的周期数加上最大修正量要放得进 Timer2 的 16 位，所以每秒拍数由机器周期频率推出：
+// 取能放得下的最小的 20 的倍数。11.0592M/12T 为 20 拍 (46080 周期)，6T 为 40 拍
+#define SOFTCLOCK_TICK_LIMIT    (65535UL - SOFTCLOCK_TRIM_MAX)
+#define SOFTCLOCK_TICKS_PER_S   (20 * ((TIMING_MCYCLE_HZ + 20 * SOFTCLOCK_TICK_LIMIT - 1) / (20 * SOFTCLOCK_TICK_LIMIT)))
+#define SOFTCLOCK_TICK_CYCLES   (TIMING_MCYCLE_HZ / SOFTCLOCK_TICKS_PER_S)
+
+// 除不尽的余数会变成固定的走时误差，要求机器周期频率能被每秒拍数整除
+typedef char SOFTCLOCK_TICK_CHECK[(TIMING_MCYCLE_HZ % SOFTCLOCK_TICKS_PER_S == 0) ? 1 : -1];
+
+// RTC 不可信时从这个时间开始走（2025-01-01 12:00:00 周三）
+static u8 code soft_default[7] = { 0x00, 0x00, 0x12, 0x01, 0x01, 0x03, 0x25 };
+
+u8 soft_degraded = 0;
+
+static u8 xdata soft_time[7];           // 软件时钟 (BCD)，与 Time[] 布局相同
+static u8 xdata soft_rtc[7];            // 对时时读到的 RTC 时间
+static u8 soft_tick = 0;                // 中断：当前秒内已过的拍数
+static volatile u8 soft_sec_count = 0;  // 中断：累计秒数（只加不减，回绕无妨）
+static u8 soft_sec_seen = 0;            // 主循环已处理到的秒数
+static u16 soft_reload;                 // 中断每次装入 RCAP2 的重装值
+
+static u8 xdata soft_hold = 0;          // 还要停走几秒（软件时钟比 RTC 快时）
+static u8 xdata soft_since_sync = 0;    // 距上次对时的秒数
+static unsigned long xdata soft_last_rtc;        // 上次对时 RTC 的周内秒数，用来发现 RTC 停走
+static int xdata soft_trim = 0;         // 重装值修正量（周期），正数 = 每个 tick 更长
+static u16 xdata drift_elapsed = 0;     // 统计窗口已过的秒数
+static long xdata drift_start;          // 窗口开始时 软件 - RTC 的秒差
+static long xdata drift_adjust;         // 窗口内对软件时钟做过的调整（跳秒为正，停走为负）
+
+// Timer2 自动重装：溢出时硬件装入 RCAP2，这里顺便换上主循环修正过的值
+void SoftClock_Isr(void) interrupt 5 {
+    TF2 = 0;
+    RCAP2H = soft_reload >> 8;
+    RCAP2L = soft_reload & 0xFF;
+    if(++soft_tick >= SOFTCLOCK_TICKS_PER_S) {
+        soft_tick = 0;
+        soft_sec_count++;
+    }
+}
+
+static void SoftClock_SetReload(void) {
+    u16 reload = (u16)(65536UL - SOFTCLOCK_TICK_CYCLES - soft_trim);
+    ET2 = 0;    // 16 位变量，中断里也要读
+    soft_reload = reload;
+    ET2 = 1;
+}
+
+// 周内秒数 (0..604799)，用来比较两个时间差几秒
+static unsigned long SoftClock_SecOfWeek(u8 *t) {
+    return (unsigned long)Cal_MinuteOfWeek(t) * 60 + BCD_to_Decimal(t[0] & 0x7F);
+}
+
+// BCD 字段加 1，到 limit 回到 first；返回 1 表示进位
+static u8 SoftClock_Inc(u8 *v, u8 limit, u8 first) {
+    u8 d = BCD_to_Decimal(*v) + 1;
+    if(d < limit) {
+        *v = Decimal_to_BCD(d);
+        return 0;
+    }
+    *v = Decimal_to_BCD(first);
+    return 1;
+}
+
+// 软件时钟走一秒
+static void SoftClock_Advance(void) {
+    u8 *t = soft_time;
+
+    if(!SoftClock_Inc(&t[0], 60, 0)) return;    // 秒
+    if(!SoftClock_Inc(&t[1], 60, 0)) return;    // 分
+    if(!SoftClock_Inc(&t[2], 24, 0)) return;    // 时
+    t[5] = (t[5] >= 7) ? 1 : t[5] + 1;          // 周（1..7，BCD 与十进制相同）
+    if(!SoftClock_Inc(&t[3], Cal_DaysInMonth(BCD_to_Decimal(t[6]), BCD_to_Decimal(t[4])) + 1, 1)) return;
+    if(!SoftClock_Inc(&t[4], 13, 1)) return;    // 月
+    SoftClock_Inc(&t[6], 100, 0);               // 年
+}
+
+static void SoftClock_Copy(u8 *dst, u8 *src) {
+    u8 i;
+    for(i = 0; i < 7; i++) dst[i] = src[i];
+}
+
+// 重新开始一个快慢统计窗口
+static void SoftClock_DriftReset(long diff) {
+    drift_elapsed = 0;
+    drift_start = diff;
+    drift_adjust = 0;
+}
+
+// 软件时钟在 drift_elapsed 秒里多走了 gain 秒，按比例加长/缩短每个 tick
+static void SoftClock_DriftTrim(long gain, long diff) {
+    long t = soft_trim + gain * (long)SOFTCLOCK_TICK_CYCLES / (long)drift_elapsed;
+
+    if(t > SOFTCLOCK_TRIM_MAX) t = SOFTCLOCK_TRIM_MAX;
+    if(t < -SOFTCLOCK_TRIM_MAX) t = -SOFTCLOCK_TRIM_MAX;
+    soft_trim = (int)t;
+    SoftClock_SetReload();
+    SoftClock_DriftReset(diff);
+}
+
+// 降级后 EventLog 不再写 DS1302，这条记录等 RTC 恢复后才写入
+static void SoftClock_Degrade(void) {
+    if(!soft_degraded) {
+        soft_degraded = 1;
+        EventLog_Append(EV_RTC_INVALID, 1, soft_time);
+    }
+}
+
+// 与 DS1302 对时
+static void SoftClock_Sync(void) {
+    unsigned long rtc_sec;
+    u8 stalled;
+    long diff, gain;
+
+    DS1302_ReadTime(soft_rtc);
+    rtc_sec = SoftClock_SecOfWeek(soft_rtc);
+    stalled = (soft_since_sync >= 2 && rtc_sec == soft_last_rtc);
+    soft_last_rtc = rtc_sec;
+    soft_since_sync = 0;
+
+    // 非法值、暂停位 (CH)，或者过了好几秒 RTC 还停在原地，都说明 RTC 不可信
+    if(!Cal_IsTimeValid(soft_rtc) || (soft_rtc[0] & 0x80) || stalled) {
+        SoftClock_Degrade();
+        return;
+    }
+
+    // RTC 恢复正常：直接采用 RTC 时间，重新统计快慢，补写降级期间的记录
+    if(soft_degraded) {
+        soft_degraded = 0;
+        SoftClock_Copy(soft_time, soft_rtc);
+        soft_hold = 0;
+        SoftClock_DriftReset(0);
+        EventLog_Flush();
+        return;
+    }
+
+    // 软件 - RTC 的秒差（还没停完的秒要扣掉），按一周回绕
+    diff = (long)SoftClock_SecOfWeek(soft_time) - soft_hold - (long)rtc_sec;
+    if(diff > 302400L) diff -= 604800L;
+    if(diff < -302400L) diff += 604800L;
+
+    if(diff > SOFTCLOCK_JUMP_S || diff < -SOFTCLOCK_JUMP_S) {
+        SoftClock_Copy(soft_time, soft_rtc);
+        soft_hold = 0;
+        SoftClock_DriftReset(0);
+        return;
+    }
+
+    // 每次对时的秒差都带着两边秒边界相位差造成的 ±1 秒量化误差，一小时只差一两秒时
+    // 算出来的快慢几乎全是噪声（1 秒/3600 秒 ≈ 278 ppm）。所以窗口满了以后继续累计，
+    // 直到偏差至少 SOFTCLOCK_TRIM_MIN_S 秒（误差不超过它的 1/4）再修正；
+    // 一直很准的话，计时到 0xFFFF 秒时按实测值修正一次（噪声约 ±30 ppm）
+    if(drift_elapsed >= SOFTCLOCK_TRIM_WINDOW_S) {
+        gain = diff - drift_start - drift_adjust;
+        if(gain >= SOFTCLOCK_TRIM_MIN_S || gain <= -SOFTCLOCK_TRIM_MIN_S || drift_elapsed == 0xFFFF) {
+            SoftClock_DriftTrim(gain, diff);
+        }
+    }
+
+    // 停走和跳秒都记为对软件时钟的调整，统计快慢时扣除
+    if(diff >= 2) {
+        soft_hold += diff;
+        drift_adjust -= diff;
+    } else if(diff <= -2) {
+        SoftClock_Copy(soft_time, soft_rtc);
+        soft_hold = 0;
+        drift_adjust -= diff;
+    }
+}
+
+u8 SoftClock_Init(void) {
+    DS1302_ReadTime(soft_time);
+    if(!Cal_IsTimeValid(soft_time) || (soft_time[0] & 0x80)) {
+        SoftClock_Copy(soft_time, soft_default);
+        soft_degraded = 1;
+    } else {
+        // 旧固件需要手动设置星期，若与日期不符则只改写星期寄存器
+        if(Cal_Normalize(soft_time)) {
+            DS1302_Write(0x8E, 0x00);
+            DS1302_Write(0x8A, soft_time[5]);
+            DS1302_Write(0x8E, 0x80);
+        }
+        soft_last_rtc = SoftClock_SecOfWeek(soft_time);
+    }
+    SoftClock_DriftReset(0);
+
+    // Timer2 16 位自动重装，定时器模式
+    T2CON = 0x00;
+    soft_reload = (u16)(65536UL - SOFTCLOCK_TICK_CYCLES);
+    RCAP2H = TH2 = soft_reload >> 8;
+    RCAP2L = TL2 = soft_reload & 0xFF;
+    ET2 = 1;
+    EA = 1;
+    TR2 = 1;
+
+    return !soft_degraded;
+}
+
+void SoftClock_Poll(void) {
+    u8 sync = 0;
+
+    while(soft_sec_seen != soft_sec_count) {
+        soft_sec_seen++;
+        if(drift_elapsed < 0xFFFF) drift_elapsed++;
+        if(soft_since_sync < 0xFF) soft_since_sync++;
+        if(soft_hold) {
+            soft_hold--;
+            continue;
+        }
+        SoftClock_Advance();
+        if(soft_time[0] == 0x00) sync = 1;  // 整分钟
+    }
+
+    if(sync || soft_since_sync >= SOFTCLOCK_RESYNC_S) SoftClock_Sync();
+}
+
+void SoftClock_Read(u8 *t) {
+    SoftClock_Copy(t, soft_time);
+}
+
+void SoftClock_Set(u8 *t) {
+    SoftClock_Copy(soft_time, t);
+    soft_hold = 0;
+    soft_since_sync = 0;
+    soft_last_rtc = SoftClock_SecOfWeek(t);
+    soft_degraded = 0;
+    SoftClock_DriftReset(0);
+    EventLog_Flush();
+}
@@ -0,0 +1,15 @@
+#ifndef __SOFTCLOCK_H__
+#define __SOFTCLOCK_H__
+
+#include "common.h"
+
+// 软件时钟：Timer2 每秒若干拍（12T 为 50 ms 一拍），主循环把整秒折算成 BCD 时间（Time[] 布局），
+// 并定期从 DS1302 重新同步。
+extern u8 soft_degraded;            // DS1302 应答不正常期间为 1
+
+u8 SoftClock_Init(void);            // 首次读 RTC + 启动 Timer2；返回 0 = RTC 不正常
+void SoftClock_Poll(void);          // 主循环每轮一次：累加秒数，到时重新同步
+void SoftClock_Read(u8 *t);         // 复制当前 BCD 时间
+void SoftClock_Set(u8 *t);          // 从 t 重新开始（时间写入 RTC 之后）
+
+#endif
@@ -0,0 +1,55 @@
+#include "text.h"
+#include "lcd1602.h"
+
+// =========================================================
+// 界面文字渲染：文字池里只存不带空格填充的单词，
+// 显示时按字段宽度现场补空格（左对齐 / 右对齐）
+// =========================================================
+
+// 消息的显示长度：各单词长度之和 + 单词间的空格（开头的空单词就是前导空格）
+static u8 Text_Len(u8 msg) {
+    u8 code *s = text_script + msg;
+    char code *w;
+    u8 len = 0;
+
+    if(*s == TEXT_END) return 0;
+    for(;;) {
+        for(w = text_pool + *s; *w; w++) len++;
+        if(*++s == TEXT_END) return len;
+        len++;
+    }
+}
+
+void Text_Show(u8 row, u8 col, u8 msg, u8 width) {
+    u8 code *s = text_script + msg;
+    char code *w;
+    u8 pad = 0;
+    u8 first = 1;
+    u8 len;
+
+    // 先算出左侧要补几个空格，剩下的宽度留给文字和右侧空格
+    if(width & TEXT_RIGHT) {
+        len = Text_Len(msg);
+        pad = width & TEXT_WIDTH_MASK;
+        pad = (len < pad) ? pad - len : 0;
+    }
+    width &= TEXT_WIDTH_MASK;
+
+    LCD_WriteCmd(0x80 | ((row ? 0x40 : 0x00) + col));
+    for(; pad; pad--, width--) LCD_WriteData(' ');
+
+    for(; *s != TEXT_END; s++) {
+        if(!first) {
+            if(!width) return;
+            LCD_WriteData(' ');
+            width--;
+        }
+        first = 0;
+        for(w = text_pool + *s; *w; w++) {
+            if(!width) return;
+            LCD_WriteData(*w);
+            width--;
+        }
+    }
+    for(; width; width--) LCD_WriteData(' ');
+}
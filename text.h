@@ -0,0 +1,15 @@
+#ifndef __TEXT_H__
+#define __TEXT_H__
+
+#include "common.h"
+#include "textpool.h"   // TXT_xxx，由 tools/uitext.txt 生成
+
+// 右对齐标志，或进 Text_Show 的 width 参数
+#define TEXT_RIGHT      0x80
+#define TEXT_WIDTH_MASK 0x1F
+
+// 在 (row, col) 显示消息 msg，用空格补齐到正好 width 列
+// （默认左对齐，带 TEXT_RIGHT 时右对齐）；超长部分截掉。
+void Text_Show(u8 row, u8 col, u8 msg, u8 width);
+
+#endif
@@ -0,0 +1,56 @@
+// Generated by tools/mktext.py from tools/uitext.txt -- do not edit.
+// pool 232/255 bytes, scripts 98/256 bytes, 35 messages
+#include "textpool.h"
+
+char code text_pool[232] =
+    "Starting...\0"
+    ">Minute:\0"
+    "History:\0"
+    "Invalid!\0"
+    "auto-off\0"
+    ">Month:\0"
+    "Aborted\0"
+    "Invalid\0"
+    "invalid\0"
+    ">Hour:\0"
+    ">Year:\0"
+    "Alarm:\0"
+    "Minute\0"
+    "Please\0"
+    "Saved!\0"
+    "System\0"
+    ">Day:\0"
+    "Alarm\0"
+    "Clock\0"
+    "Power\0"
+    "Smart\0"
+    "Time!\0"
+    "empty\0"
+    "fired\0"
+    "Hour\0"
+    "RING\0"
+    "Save\0"
+    "Time\0"
+    "OFF\0"
+    "RTC\0"
+    "Set\0"
+    "set\0"
+    "20\0"
+    "AM\0"
+    "ON\0"
+    "PM\0"
+    "on\0"
+    "?\0"
+    "W\0";
+
+u8 code text_script[98] = {
+    0x0B, 0x0B, 0x99, 0x8D, 0xFF, 0x0B, 0x6C, 0xCD, 0xC0, 0xFF, 0x0B, 0x0B,
+    0x00, 0xFF, 0x0B, 0x40, 0x9F, 0xFF, 0x0B, 0x5E, 0xC5, 0xFF, 0x0B, 0x5E,
+    0xDB, 0xFF, 0x0B, 0x87, 0x73, 0xFF, 0x0B, 0xBB, 0x38, 0xFF, 0x0B, 0xC0,
+    0x73, 0xFF, 0x0B, 0xC9, 0x1E, 0xFF, 0xCD, 0x7A, 0xC0, 0xFF, 0xCD, 0x87,
+    0xC0, 0xFF, 0x15, 0xA5, 0xFF, 0x57, 0xD5, 0xFF, 0x87, 0x27, 0xFF, 0x87,
+    0x2C, 0xFF, 0x87, 0xAB, 0xFF, 0x93, 0xE1, 0xFF, 0xC0, 0xD1, 0xFF, 0xC9,
+    0x48, 0xFF, 0x0C, 0xFF, 0x30, 0xFF, 0x50, 0xFF, 0x5E, 0xFF, 0x65, 0xFF,
+    0x81, 0xFF, 0xB1, 0xFF, 0xB6, 0xFF, 0xD8, 0xFF, 0xDE, 0xFF, 0xE4, 0xFF,
+    0xE6, 0xFF
+};
@@ -0,0 +1,49 @@
+// Generated by tools/mktext.py from tools/uitext.txt -- do not edit.
+// pool 232/255 bytes, scripts 98/256 bytes, 35 messages
+#ifndef __TEXTPOOL_H__
+#define __TEXTPOOL_H__
+
+#include "common.h"
+
+#define TEXT_END            0xFF
+
+#define TXT_BLANK           0x04    // (blank)
+#define TXT_SMART_CLOCK     0x00    // "  Smart Clock"
+#define TXT_STARTING        0x0A    // "  Starting..."
+#define TXT_RTC_INVALID     0x26    // " RTC Invalid!"
+#define TXT_PLEASE_SET      0x05    // " Please Set Time"
+#define TXT_AM              0x5A    // "AM"
+#define TXT_PM              0x5C    // "PM"
+#define TXT_ALARM           0x50    // "Alarm:"
+#define TXT_ON              0x18    // "ON"
+#define TXT_OFF             0x14    // "OFF"
+#define TXT_RING            0x58    // "RING"
+#define TXT_ALARM_ON        0x16    // " Alarm: ON"
+#define TXT_ALARM_OFF       0x12    // " Alarm: OFF"
+#define TXT_SET_ALARM       0x2E    // "Set Alarm Time"
+#define TXT_SET_TIME        0x2A    // "Set System Time"
+#define TXT_HOUR            0x56    // "Hour"
+#define TXT_MINUTE          0x52    // "Minute"
+#define TXT_ED_YEAR         0x35    // ">Year: 20"
+#define TXT_ED_MONTH        0x4C    // ">Month:"
+#define TXT_ED_DAY          0x54    // ">Day:"
+#define TXT_ED_HOUR         0x4E    // ">Hour:"
+#define TXT_ED_MINUTE       0x4A    // ">Minute:"
+#define TXT_WEEK            0x60    // "W"
+#define TXT_ALARM_SAVED     0x1A    // " Alarm Saved!"
+#define TXT_TIME_SAVED      0x22    // " Time Saved!"
+#define TXT_INVALID_TIME    0x0E    // " Invalid Time!"
+#define TXT_SAVE_ABORTED    0x1E    // " Save Aborted"
+#define TXT_NO_HISTORY      0x32    // "History: empty"
+#define TXT_EV_NONE         0x5E    // "?"
+#define TXT_EV_POWER_ON     0x41    // "Power on"
+#define TXT_EV_RTC_INVALID  0x47    // "RTC invalid"
+#define TXT_EV_TIME_SET     0x44    // "Time set"
+#define TXT_EV_ALARM_FIRED  0x3E    // "Alarm fired"
+#define TXT_EV_ALARM_OFF    0x3B    // "Alarm off"
+#define TXT_EV_ALARM_AUTO   0x38    // "Alarm auto-off"
+
+extern char code text_pool[232];
+extern u8 code text_script[98];
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef __TIMING_H__
+#define __TIMING_H__
+
+#include <intrins.h>
+#include "common.h"
+
+// =========================================================
+// 时钟配置：整个工程只在这里描述晶振，换板子/换 6T 芯片只改这两项
+// =========================================================
+#ifndef FOSC
+#define FOSC        11059200UL  // 晶振频率 (Hz)，常见 11.0592M / 12M
+#endif
+#ifndef CLOCK_DIV
+#define CLOCK_DIV   12          // 每个机器周期的时钟数：标准 12T；STC 6T(双倍速) 改为 6
+#endif
+
+#define TIMING_MCYCLE_HZ    (FOSC / CLOCK_DIV)                      // 机器周期频率
+#define TIMING_MCYCLE_NS    ((1000000000UL + TIMING_MCYCLE_HZ - 1) / TIMING_MCYCLE_HZ)
+#define TIMING_CYCLES_PER_MS ((TIMING_MCYCLE_HZ + 999UL) / 1000UL)
+
+// 纳秒/微秒 -> 机器周期（向上取整，只会比要求长，不会短）
+#define TIMING_NS_TO_CYCLES(ns) \
+    (((unsigned long)(ns) * TIMING_CYCLES_PER_MS + 999999UL) / 1000000UL)
+#define TIMING_US_TO_CYCLES(us) \
+    (((unsigned long)(us) * TIMING_CYCLES_PER_MS + 999UL) / 1000UL)
+
+// ---------------------------------------------------------
+// 汇编实现的延时（timing.a51），周期数与 C 编译器优化级别无关：
+//   Timing_Spin(n)      : MOV R7,#n + LCALL + n*DJNZ + RET = 5 + 2n 个机器周期 (n=1..255)
+//   Timing_DelayMs(...) : 每毫秒 4 + outer*(4 + 2*inner) 个机器周期，另每 256ms 多 2 个
+// ---------------------------------------------------------
+void Timing_Spin(u8 n);
+void Timing_DelayMs(u16 ms, u8 outer, u8 inner);
+
+// 凑出至少 c 个机器周期所需的 Timing_Spin 参数
+#define TIMING_SPIN_COUNT(c)    (((c) <= 7) ? 1 : (((c) - 5 + 1) / 2))
+// Timing_Spin 的参数只有 8 位，最多 5 + 2*255 个机器周期；c 超出时参数会溢出变短，
+// 这里让编译报错（数组长度为 -1），同 softclock.c 的 SOFTCLOCK_TICK_CHECK
+#define TIMING_SPIN_MAX         (5 + 2 * 255)
+#define TIMING_SPIN_CHECK(c)    ((void)sizeof(char[((c) <= TIMING_SPIN_MAX) ? 1 : -1]))
+
+// 1ms 的两层循环参数：outer 尽量小，inner 不超过 255
+#define TIMING_MS_OUTER  ((TIMING_CYCLES_PER_MS - 4 + 513) / 514)
+#define TIMING_MS_INNER  ((((TIMING_CYCLES_PER_MS - 4 + TIMING_MS_OUTER - 1) / TIMING_MS_OUTER) - 4 + 1) / 2)
+
+// 精确到机器周期的短延时：c 为编译期常量，8 个周期以下直接展开成 _nop_()，
+// 否则调用 Timing_Spin。常量条件由 C51 的 Dead Code Elimination 去掉（OPTIMIZE >= 1）。
+#define TIMING_DELAY_CYCLES(c) do {                         \
+        TIMING_SPIN_CHECK(c);                               \
+        if((c) >= 8) Timing_Spin(TIMING_SPIN_COUNT(c));     \
+        else {                                              \
+            if((c) > 0) _nop_();                            \
+            if((c) > 1) _nop_();                            \
+            if((c) > 2) _nop_();                            \
+            if((c) > 3) _nop_();                            \
+            if((c) > 4) _nop_();                            \
+            if((c) > 5) _nop_();                            \
+            if((c) > 6) _nop_();                            \
+        }                                                   \
+    } while(0)
+
+// ---------------------------------------------------------
+// 总线边沿时序：两次改写引脚之间至少隔着一条指令（>= 1 个机器周期），
+// 这一周期计入边沿宽度，只补足剩余部分，让驱动跑在手册允许的最快速度
+// ---------------------------------------------------------
+#define TIMING_EDGE_CYCLES(ns)  ((TIMING_NS_TO_CYCLES(ns) > 1) ? (TIMING_NS_TO_CYCLES(ns) - 1) : 0)
+#define TIMING_EDGE_DELAY(ns)   TIMING_DELAY_CYCLES(TIMING_EDGE_CYCLES(ns))
+
+// 实际边沿能不能满足手册，由 tools/host 的引脚级模型跑真实驱动来检查：
+//   make -C tools/host check   （逐个边沿打印相对手册最小值的余量）
+
+#define DelayMs(ms)             Timing_DelayMs((ms), TIMING_MS_OUTER, TIMING_MS_INNER)
+
+#endif
@@ -0,0 +1,201 @@
+// DS1302 model (see ds1302_model.h).
+#include <string.h>
+#include "ds1302_model.h"
+
+Ds1302Model rtc = { {0}, {0}, 0, 0, {
+    { "tCC",  "RST high -> first CLK rise",         1000 },
+    { "tCWH", "RST low time",                       1000 },
+    { "tDC",  "IO change -> CLK rise (write)",        50 },
+    { "tCDH", "CLK rise -> IO change (hold)",         70 },
+    { "tCH",  "CLK high time",                       250 },
+    { "tCL",  "CLK low time",                        250 },
+    { "tCDD", "CLK fall -> IO sampled (read)",       200 },
+    { "tCCH", "last CLK edge -> RST low",             60 },
+} };
+
+#define RTC_CDD_CLOCKS  ((hw_clocks)(200.0 * FOSC / 1e9 + 0.999))
+
+enum { PH_IDLE, PH_CMD, PH_WRITE, PH_READ, PH_IGNORE };
+
+// Pins come out of reset high (port latches = 0xFF)
+static int rst = 1, clk = 1, io = 1;
+static hw_clocks rst_rise, rst_fall, clk_rise, clk_fall, clk_edge, io_change;
+static bool seen_rst_fall, seen_clk_fall, clocked;
+static int phase = PH_IDLE;
+static unsigned char cmd, shift, nbits, burst_at, rises;
+static bool driving;
+static int out_old, out_new;
+static hw_clocks out_time;
+static unsigned char out_byte, out_bit;
+static hw_clocks second_start;
+
+static unsigned char bcd(unsigned char v) { return (v / 10) << 4 | (v % 10); }
+static unsigned char bin(unsigned char v) { return (v >> 4) * 10 + (v & 0x0F); }
+
+static unsigned char days_in_month(unsigned char month, unsigned char year) {
+    static const unsigned char days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if(month == 2 && year % 4 == 0) return 29;
+    return month >= 1 && month <= 12 ? days[month - 1] : 31;
+}
+
+// One second in 24-hour mode; fields that are not valid BCD just count on
+// as the binary value would, which is close enough for a garbage start
+static void tick_second(void) {
+    unsigned char *r = rtc.reg;
+    unsigned char s = bin(r[0] & 0x7F) + 1, m, h, d, mo, y;
+    if(s < 60) { r[0] = bcd(s); return; }
+    r[0] = 0;
+    m = bin(r[1]) + 1;
+    if(m < 60) { r[1] = bcd(m); return; }
+    r[1] = 0;
+    h = bin(r[2] & 0x3F) + 1;
+    if(h < 24) { r[2] = bcd(h); return; }
+    r[2] = 0;
+    r[5] = r[5] >= 7 ? 1 : r[5] + 1;
+    d = bin(r[3]) + 1;
+    mo = bin(r[4]);
+    y = bin(r[6]);
+    if(d <= days_in_month(mo, y)) { r[3] = bcd(d); return; }
+    r[3] = 1;
+    if(++mo <= 12) { r[4] = bcd(mo); return; }
+    r[4] = 1;
+    r[6] = bcd((y + 1) % 100);
+}
+
+void rtc_update(void) {
+    if(rtc.reg[0] & 0x80) {             // CH: oscillator halted
+        second_start = hw_now;
+        return;
+    }
+    while(hw_now - second_start >= FOSC) {
+        second_start += FOSC;
+        tick_second();
+    }
+}
+
+void rtc_power_on(void) {
+    memset(rtc.reg, 0, sizeof(rtc.reg));
+    memset(rtc.ram, 0, sizeof(rtc.ram));
+    rtc.reg[0] = 0x80;                  // clock halted until someone clears CH
+    rtc.reg[7] = 0x80;                  // write protected
+    second_start = hw_now;
+}
+
+static unsigned char read_byte(void) {
+    unsigned char addr = (cmd >> 1) & 0x1F;
+    bool burst = addr == 31;
+    if(burst) addr = burst_at;
+    if(cmd & 0x40) return addr < 31 ? rtc.ram[addr] : 0;
+    rtc_update();
+    return addr < 8 ? rtc.reg[addr] : 0;
+}
+
+static void write_byte(unsigned char value) {
+    unsigned char addr = (cmd >> 1) & 0x1F;
+    if(addr == 31) addr = burst_at++;
+    else phase = PH_IGNORE;             // single byte: later clocks are ignored
+    if(!(cmd & 0x40) && addr == 7) {
+        rtc.reg[7] = value & 0x80;      // control: only WP is writable
+        return;
+    }
+    if(rtc.reg[7] & 0x80) return;
+    if(cmd & 0x40) {
+        if(addr < 31) rtc.ram[addr] = value;
+    } else if(addr < 7) {
+        rtc_update();
+        rtc.reg[addr] = value;
+        if(addr == 0) second_start = hw_now;    // writing seconds restarts the divider
+    }
+}
+
+static void check_contention(void) {
+    if(driving && !io && (out_old || out_new)) rtc.faults++;
+}
+
+static int out_level(hw_clocks when) {
+    return when >= out_time ? out_new : out_old;
+}
+
+void rtc_rst(int level) {
+    rst = level;
+    if(level) {
+        if(seen_rst_fall) hw_rule(rtc.rules[RTC_T_CWH], rst_fall, hw_now);
+        if(clk) rtc.faults++;       // CLK must be low when RST goes high
+        rst_rise = hw_now;
+        phase = PH_CMD;
+        nbits = shift = rises = burst_at = 0;
+        clocked = false;
+    } else {
+        if(clocked) hw_rule(rtc.rules[RTC_T_CCH], clk_edge, hw_now);
+        rtc.bytes += rises / 8;
+        phase = PH_IDLE;
+        driving = false;
+        rst_fall = hw_now;
+        seen_rst_fall = true;
+    }
+}
+
+void rtc_clk(int level) {
+    clk = level;
+    if(level) {
+        if(rst) {
+            if(!clocked) hw_rule(rtc.rules[RTC_T_CC], rst_rise, hw_now);
+            if(seen_clk_fall) hw_rule(rtc.rules[RTC_T_CL], clk_fall, hw_now);
+            rises++;
+            if(phase == PH_CMD || phase == PH_WRITE) {
+                hw_rule(rtc.rules[RTC_T_DC], io_change, hw_now);
+                shift |= io << nbits;
+                if(++nbits == 8) {
+                    if(phase == PH_WRITE) {
+                        write_byte(shift);
+                    } else {
+                        cmd = shift;
+                        if(!(cmd & 0x80)) phase = PH_IGNORE;
+                        else phase = (cmd & 0x01) ? PH_READ : PH_WRITE;
+                    }
+                    nbits = shift = 0;
+                }
+            }
+            clocked = true;
+        }
+        clk_rise = clk_edge = hw_now;
+    } else {
+        if(rst) {
+            hw_rule(rtc.rules[RTC_T_CH], clk_rise, hw_now);
+            if(phase == PH_READ) {
+                // Next data bit, valid tCDD after this edge
+                if(!driving) {
+                    driving = true;
+                    out_old = 1;
+                    out_byte = read_byte();
+                    out_bit = 0;
+                } else {
+                    out_old = out_level(hw_now);
+                    if(++out_bit == 8) {
+                        out_bit = 0;
+                        if(((cmd >> 1) & 0x1F) == 31) burst_at++;
+                        out_byte = read_byte();
+                    }
+                }
+                out_new = (out_byte >> out_bit) & 1;
+                out_time = hw_now + RTC_CDD_CLOCKS;
+                check_contention();
+            }
+        }
+        clk_fall = clk_edge = hw_now;
+        seen_clk_fall = true;
+    }
+}
+
+void rtc_io(int level) {
+    io = level;
+    if(rst && clocked) hw_rule(rtc.rules[RTC_T_CDH], clk_rise, hw_now);
+    io_change = hw_now;
+    check_contention();
+}
+
+int rtc_io_level(hw_clocks when) {
+    if(!driving) return 1;
+    hw_rule(rtc.rules[RTC_T_CDD], clk_fall, when);
+    return out_level(when);
+}
@@ -0,0 +1,39 @@
+// DS1302 on the host: 3-wire protocol, registers, RAM and timekeeping,
+// driven by the pin edges the firmware makes (tools/host).
+//
+// The part is modelled at its datasheet limits (VCC = 5 V): read data only
+// becomes valid tCDD after the falling clock edge, so a driver that samples
+// too early reads the previous bit, exactly like a slow board would show.
+#ifndef HOST_DS1302_MODEL_H
+#define HOST_DS1302_MODEL_H
+
+#include "hw.h"
+
+enum {
+    RTC_T_CC, RTC_T_CWH, RTC_T_DC, RTC_T_CDH, RTC_T_CH, RTC_T_CL,
+    RTC_T_CDD, RTC_T_CCH,
+    RTC_RULES
+};
+
+struct Ds1302Model {
+    // Registers 0x80..0x8E (seconds .. control) in BCD as the part stores them
+    unsigned char reg[8];
+    unsigned char ram[31];
+    unsigned long bytes;        // bytes shifted (8 clocks each), all directions
+    unsigned long faults;       // IO driven against a low latch, RST raised with CLK high
+    EdgeRule rules[RTC_RULES];
+};
+
+extern Ds1302Model rtc;
+
+void rtc_power_on(void);
+// Whole seconds since the last call are added to the time registers
+void rtc_update(void);
+
+// Pin events from the board wiring
+void rtc_rst(int level);
+void rtc_clk(int level);
+void rtc_io(int level);
+int rtc_io_level(hw_clocks when);
+
+#endif
@@ -0,0 +1,88 @@
+// Bus timing check: runs the real DS1302 and LCD drivers against the pin
+// models and reports every datasheet edge with its worst-case slack at the
+// FOSC/CLOCK_DIV the drivers were built for.
+//
+// The DS1302 driver is built with DS1302_CAL_MARGIN=0, so after calibrating
+// against a part that is exactly at its datasheet limits it must settle on
+// level 0, the fastest timing the firmware can produce.
+#include <stdio.h>
+#include <string.h>
+#include "hw.h"
+#include "ds1302_model.h"
+#include "lcd_model.h"
+#include "firmware.h"
+
+static unsigned char glyph[8] = { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00 };
+
+static int failures = 0;
+
+static void expect(bool ok, const char *what) {
+    if(ok) return;
+    printf("FAILED: %s\n", what);
+    failures++;
+}
+
+static void run_lcd(void) {
+    char text[] = "Edge check";
+    LCD_Init();
+    LCD_SetGlyph(0, glyph);
+    LCD_ShowString(0, 0, text);
+    LCD_ShowNum(1, 0, 2025, 4);
+    LCD_ShowChar(1, 5, 0);
+    LCD_Flush();
+    expect(lcd_frame() == "|Edge check      |\n|2025 ⁰          |\n", "LCD shows what was written");
+    LCD_WriteCmd(0x01);
+    LCD_ShowString(1, 3, text);
+    LCD_Flush();
+    expect(lcd_frame() == "|                |\n|   Edge check   |\n", "LCD clear and rewrite");
+}
+
+static void run_rtc(void) {
+    unsigned char set[7] = { 0x56, 0x34, 0x12, 0x15, 0x06, 0x07, 0x25 };
+    unsigned char got[7], ram[27], back[27];
+    unsigned char i;
+
+    // A part that kept time on its battery, with garbage in the RAM
+    memset(rtc.ram, 0xC3, sizeof(rtc.ram));
+    rtc.reg[0] = 0x00;
+
+    DS1302_Init();
+    expect(rtc.ram[DS1302_RAM_CAL] == 0xA0, "calibration settles on level 0 at datasheet timing");
+
+    DS1302_SetTime(set);
+    DS1302_ReadTime(got);
+    expect(memcmp(set, got, 7) == 0, "time reads back as set");
+
+    DS1302_WriteRam(3, 0x5A);
+    expect(rtc.ram[3] == 0x5A && DS1302_ReadRam(3) == 0x5A, "single RAM byte");
+
+    for(i = 0; i < sizeof(ram); i++) ram[i] = (unsigned char)(i * 37 + 11);
+    DS1302_WriteRamBurst(ram, sizeof(ram));
+    expect(memcmp(rtc.ram, ram, sizeof(ram)) == 0, "burst write");
+    DS1302_ReadRamBurst(back, sizeof(back));
+    expect(memcmp(back, ram, sizeof(ram)) == 0, "burst read");
+    expect(rtc.ram[DS1302_RAM_CAL] == 0xA0, "no fallback to the safe timing");
+}
+
+int main(void) {
+    char title[96];
+
+    rtc_power_on();
+    lcd_power_on();
+    hw_vector(1, LCD_Isr);
+
+    run_lcd();
+    run_rtc();
+
+    printf("FOSC = %lu Hz, CLOCK_DIV = %d, machine cycle = %.1f ns\n\n",
+           (unsigned long)FOSC, CLOCK_DIV, hw_ns(HW_CYCLE));
+    snprintf(title, sizeof(title), "DS1302 (%lu bytes)", rtc.bytes);
+    failures += hw_report(stdout, title, rtc.rules, RTC_RULES);
+    snprintf(title, sizeof(title), "\nHD44780 (%lu bytes)", lcd.bytes);
+    failures += hw_report(stdout, title, lcd.rules, LCD_RULES);
+    expect(rtc.faults == 0, "DS1302 bus faults");
+    expect(lcd.glitches == 0, "RS/RW changed while EN was high");
+
+    printf("\n%s\n", failures ? "EDGE CHECK FAILED" : "edge check passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,23 @@
+// Firmware entry points for the host drivers.  Include after every system
+// header: the Keil mappings are only live while the firmware headers are
+// read, and are removed again below.
+#ifndef HOST_FIRMWARE_H
+#define HOST_FIRMWARE_H
+
+#include "keil.h"
+#include "lcd1602.h"
+#include "ds1302.h"
+
+void LCD_Isr(void);
+void SoftClock_Isr(void);
+void fw_main(void);
+
+#undef int
+#undef code
+#undef xdata
+#undef idata
+#undef pdata
+#undef bdata
+#undef reentrant
+
+#endif
@@ -0,0 +1,303 @@
+// Host board model: ports, timers, interrupts and the pin wiring to the
+// DS1302 and LCD models (see hw.h for the cost model).
+#include <stdarg.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include "hw.h"
+#include "ds1302_model.h"
+#include "lcd_model.h"
+#include "reg52.h"
+#include "intrins.h"
+
+Port P0(0), P1(1), P2(2), P3(3);
+SfrBit EA(HW_BIT_EA), ET0(HW_BIT_ET0), ET2(HW_BIT_ET2), TR0(HW_BIT_TR0), TR2(HW_BIT_TR2);
+SfrBit TF0(HW_BIT_TF0), TF2(HW_BIT_TF2), EXF2(HW_BIT_EXF2), PT0(HW_BIT_PT0), PT2(HW_BIT_PT2), PS(HW_BIT_PS);
+unsigned char TMOD, TCON, IE, IP, PCON, TH0, TL0, TH1, TL1;
+unsigned char T2CON, TH2, TL2, RCAP2H, RCAP2L;
+
+hw_clocks hw_now = 0;
+void (*hw_lcd_idle)(void) = 0;
+void (*hw_beep_changed)(int on) = 0;
+
+static unsigned char latch[4] = { 0xFF, 0xFF, 0xFF, 0xFF };    // port latches after reset
+static unsigned char keys = 0;          // P3.0..P3.3 held low
+static unsigned char bits[HW_BIT_COUNT];
+static void (*vectors[8])(void);
+static bool in_isr = false;
+
+static bool t0_armed = false, t2_armed = false;
+static hw_clocks t0_due, t2_due;
+
+struct Call {
+    hw_clocks when;
+    void (*fn)(void);
+};
+static std::vector<Call> calls;
+
+void hw_fatal(const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    fprintf(stderr, "host: ");
+    vfprintf(stderr, fmt, ap);
+    fprintf(stderr, " (at %.3f ms)\n", hw_ns(hw_now) / 1e6);
+    va_end(ap);
+    exit(2);
+}
+
+double hw_ns(hw_clocks clocks) {
+    return (double)clocks * 1e9 / (double)FOSC;
+}
+
+// ---------------------------------------------------------------------------
+// Timers: Timer0 in mode 1 (16 bit, the ISR writes the next count) and
+// Timer2 in auto-reload mode (RCAP2 is loaded by the hardware on overflow)
+// ---------------------------------------------------------------------------
+static hw_clocks count_to_overflow(unsigned char hi, unsigned char lo) {
+    return (65536UL - ((unsigned)hi << 8 | lo)) * HW_CYCLE;
+}
+
+static void timer0_arm(void) {
+    t0_armed = true;
+    t0_due = hw_now + count_to_overflow(TH0, TL0);
+}
+
+static bool irq_pending(void) {
+    if(in_isr || !bits[HW_BIT_EA]) return false;
+    if(bits[HW_BIT_TF0] && bits[HW_BIT_ET0] && vectors[1]) return true;
+    if((bits[HW_BIT_TF2] || bits[HW_BIT_EXF2]) && bits[HW_BIT_ET2] && vectors[5]) return true;
+    return false;
+}
+
+static void irq_run(void) {
+    in_isr = true;
+    if(bits[HW_BIT_TF0] && bits[HW_BIT_ET0] && vectors[1]) {
+        bits[HW_BIT_TF0] = 0;          // cleared by the hardware on vectoring
+        vectors[1]();
+        // The ISR has written the next count; mode 1 restarts from it
+        if(bits[HW_BIT_TR0] && !t0_armed) timer0_arm();
+    } else {
+        vectors[5]();                   // TF2 is left for the ISR to clear
+    }
+    in_isr = false;
+}
+
+// Earliest timer overflow or scheduled call, ~0 if there is none
+static hw_clocks next_event(void) {
+    hw_clocks next = ~(hw_clocks)0;
+    size_t i;
+    if(t0_armed && t0_due < next) next = t0_due;
+    if(t2_armed && t2_due < next) next = t2_due;
+    if(!in_isr) {
+        for(i = 0; i < calls.size(); i++) {
+            if(calls[i].when < next) next = calls[i].when;
+        }
+    }
+    return next;
+}
+
+static void fire_events(void) {
+    size_t i;
+    if(t0_armed && t0_due <= hw_now) {
+        t0_armed = false;
+        bits[HW_BIT_TF0] = 1;
+    }
+    if(t2_armed && t2_due <= hw_now) {
+        t2_due += count_to_overflow(RCAP2H, RCAP2L);
+        bits[HW_BIT_TF2] = 1;
+    }
+    if(in_isr) return;
+    for(i = 0; i < calls.size(); i++) {
+        if(calls[i].when <= hw_now) {
+            void (*fn)(void) = calls[i].fn;
+            calls.erase(calls.begin() + i);
+            fn();
+            return;
+        }
+    }
+}
+
+void hw_advance(hw_clocks clocks) {
+    hw_clocks end = hw_now + clocks;
+    hw_clocks next;
+    for(;;) {
+        if(irq_pending()) {
+            // The interrupted code carries on afterwards for what it had left
+            hw_clocks left = end - hw_now;
+            irq_run();
+            end = hw_now + left;
+            continue;
+        }
+        next = next_event();
+        if(next > end) break;
+        if(next > hw_now) hw_now = next;
+        fire_events();
+    }
+    hw_now = end;
+}
+
+// Empty wait loops (while(TR0); ...) jump to the next thing that can end them
+void hw_spin(void) {
+    hw_clocks next = next_event();
+    if(irq_pending() || next <= hw_now + HW_CYCLE) {
+        hw_advance(HW_CYCLE);
+        return;
+    }
+    if(next == ~(hw_clocks)0) hw_fatal("firmware waits for an event that can never come");
+    hw_advance(next - hw_now);
+}
+
+void hw_vector(unsigned char n, void (*isr)(void)) {
+    vectors[n] = isr;
+}
+
+void hw_at(hw_clocks when, void (*fn)(void)) {
+    Call c = { when, fn };
+    calls.push_back(c);
+}
+
+// ---------------------------------------------------------------------------
+// Delay primitives with the cycle counts of timing.a51
+// ---------------------------------------------------------------------------
+void _nop_(void) {
+    hw_advance(HW_CYCLE);
+}
+
+void Timing_Spin(unsigned char n) {
+    hw_advance((5 + 2 * (hw_clocks)n) * HW_CYCLE);
+}
+
+void Timing_DelayMs(unsigned short ms, unsigned char outer, unsigned char inner) {
+    hw_clocks per_ms = 4 + (hw_clocks)outer * (4 + 2 * (hw_clocks)inner);
+    hw_advance(((hw_clocks)ms * per_ms + 2 * ((ms + 255) / 256)) * HW_CYCLE);
+}
+
+// ---------------------------------------------------------------------------
+// Pins.  Board wiring:
+//   P0        LCD D0..D7          P2.5  LCD RW    P2.6  LCD RS    P2.7  LCD EN
+//   P2.0      buzzer (active low)
+//   P3.0..3   keys K2 K1 K3 K4 to ground
+//   P3.4      DS1302 IO           P3.5  DS1302 RST                P3.6  DS1302 CLK
+// ---------------------------------------------------------------------------
+static void pin_changed(unsigned char port, unsigned char bit, int level) {
+    if(port == 2) {
+        if(bit == 0 && hw_beep_changed) hw_beep_changed(!level);
+        else if(bit == 5) lcd_rw(level);
+        else if(bit == 6) lcd_rs(level);
+        else if(bit == 7) lcd_en(level);
+    } else if(port == 3) {
+        if(bit == 4) rtc_io(level);
+        else if(bit == 5) rtc_rst(level);
+        else if(bit == 6) rtc_clk(level);
+    }
+}
+
+// Level on the pin at the given time: the latch wired-AND with whatever
+// pulls it low from outside
+static int pin_level(unsigned char port, unsigned char bit, hw_clocks when) {
+    int level = (latch[port] >> bit) & 1;
+    if(port == 3 && bit < 4 && (keys >> bit) & 1) level = 0;
+    if(port == 3 && bit == 4) level &= rtc_io_level(when);
+    return level;
+}
+
+static void port_latch(unsigned char port, unsigned char value) {
+    unsigned char changed = latch[port] ^ value;
+    unsigned char bit;
+    latch[port] = value;
+    if(port == 0) {
+        if(changed) lcd_data(value);
+        return;
+    }
+    for(bit = 0; bit < 8; bit++) {
+        if((changed >> bit) & 1) pin_changed(port, bit, (value >> bit) & 1);
+    }
+}
+
+void hw_pin_write(unsigned char port, unsigned char bit, unsigned char level) {
+    hw_advance(HW_CYCLE);
+    port_latch(port, level ? latch[port] | (1 << bit) : latch[port] & ~(1 << bit));
+}
+
+void hw_port_write(unsigned char port, unsigned char value) {
+    hw_advance(HW_CYCLE);
+    port_latch(port, value);
+}
+
+unsigned char hw_pin_read(unsigned char port, unsigned char bit) {
+    hw_advance(HW_CYCLE);
+    return pin_level(port, bit, hw_now - HW_CYCLE + HW_CYCLE * 5 / 6);
+}
+
+unsigned char hw_port_read(unsigned char port) {
+    unsigned char value = 0, bit;
+    hw_advance(HW_CYCLE);
+    for(bit = 0; bit < 8; bit++) {
+        value |= pin_level(port, bit, hw_now - HW_CYCLE + HW_CYCLE * 5 / 6) << bit;
+    }
+    return value;
+}
+
+void hw_key(unsigned char bit, int held) {
+    if(held) keys |= 1 << bit;
+    else keys &= ~(1 << bit);
+}
+
+int hw_beep(void) {
+    return !(latch[2] & 1);
+}
+
+// ---------------------------------------------------------------------------
+// Timer and interrupt control bits
+// ---------------------------------------------------------------------------
+void hw_bit_write(unsigned char id, unsigned char level) {
+    unsigned char was = bits[id];
+    hw_advance(HW_CYCLE);
+    bits[id] = level;
+    if(id == HW_BIT_TR0) {
+        if(level && !was) timer0_arm();
+        if(!level) {
+            t0_armed = false;
+            if(was && hw_lcd_idle) hw_lcd_idle();
+        }
+    } else if(id == HW_BIT_TR2) {
+        if(level && !was) {
+            t2_armed = true;
+            t2_due = hw_now + count_to_overflow(TH2, TL2);
+        }
+        if(!level) t2_armed = false;
+    }
+}
+
+unsigned char hw_bit_read(unsigned char id) {
+    hw_advance(HW_CYCLE);
+    return bits[id];
+}
+
+// ---------------------------------------------------------------------------
+// Rules
+// ---------------------------------------------------------------------------
+void hw_rule(EdgeRule &rule, hw_clocks from, hw_clocks to) {
+    double ns = to >= from ? hw_ns(to - from) : -hw_ns(from - to);
+    if(rule.count == 0 || ns < rule.worst_ns) rule.worst_ns = ns;
+    rule.count++;
+}
+
+int hw_report(FILE *out, const char *title, EdgeRule *rules, int n) {
+    int i, failed = 0;
+    fprintf(out, "%s\n", title);
+    fprintf(out, "  %-7s %-34s %10s %12s %12s %8s\n", "edge", "", "min ns", "shortest ns", "slack ns", "count");
+    for(i = 0; i < n; i++) {
+        EdgeRule &r = rules[i];
+        if(r.count == 0) {
+            fprintf(out, "  %-7s %-34s %10.0f %12s %12s %8s  NOT EXERCISED\n", r.name, r.what, r.min_ns, "-", "-", "0");
+            failed++;
+            continue;
+        }
+        double slack = r.worst_ns - r.min_ns;
+        fprintf(out, "  %-7s %-34s %10.0f %12.1f %12.1f %8lu%s\n", r.name, r.what, r.min_ns,
+                r.worst_ns, slack, r.count, slack < 0 ? "  VIOLATED" : "");
+        if(slack < 0) failed++;
+    }
+    return failed;
+}
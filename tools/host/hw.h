@@ -0,0 +1,69 @@
+// Host board model for the clock firmware (tools/host).
+//
+// Time is kept in oscillator clocks since power-on.  The firmware runs
+// natively; only what it does to the hardware costs time:
+//   - every port/pin access and every timer control bit is one machine
+//     cycle; a write takes effect at the end of that cycle and a read
+//     samples the pin at S5P2, 5/6 of the way through it (as on the 8051);
+//   - Timing_Spin / Timing_DelayMs / _nop_ cost exactly what timing.a51
+//     documents;
+//   - all other C code is free.
+// Intervals between pin edges are therefore lower bounds of what the real
+// part produces, which is the safe direction for checking minimum timings.
+#ifndef HOST_HW_H
+#define HOST_HW_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifndef FOSC
+#define FOSC        11059200UL
+#endif
+#ifndef CLOCK_DIV
+#define CLOCK_DIV   12
+#endif
+
+typedef uint64_t hw_clocks;
+
+#define HW_CYCLE        ((hw_clocks)CLOCK_DIV)
+#define HW_MS(ms)       ((hw_clocks)(ms) * FOSC / 1000)
+
+extern hw_clocks hw_now;
+
+double hw_ns(hw_clocks clocks);
+
+// Let simulated time run, servicing timers, interrupts and scheduled calls
+void hw_advance(hw_clocks clocks);
+// Interrupt service routines, by 8051 vector number (1 = Timer0, 5 = Timer2)
+void hw_vector(unsigned char n, void (*isr)(void));
+// Call fn from the main context once hw_now reaches when
+void hw_at(hw_clocks when, void (*fn)(void));
+// Keys K1..K4 on P3.0..P3.3 pull the pin low while held
+void hw_key(unsigned char bit, int held);
+// Buzzer on P2.0, active low
+int hw_beep(void);
+// Called whenever the firmware stops Timer0 (LCD queue drained)
+extern void (*hw_lcd_idle)(void);
+// Called whenever the buzzer pin changes
+extern void (*hw_beep_changed)(int on);
+
+// ---------------------------------------------------------------------------
+// Datasheet minimum between two edges.  Each recorded interval is compared
+// against min_ns; the report lists the shortest interval seen and its slack.
+// ---------------------------------------------------------------------------
+struct EdgeRule {
+    const char *name;       // datasheet symbol
+    const char *what;       // which two edges
+    double min_ns;
+    double worst_ns;        // shortest interval recorded so far
+    unsigned long count;    // how many intervals were recorded
+};
+
+void hw_rule(EdgeRule &rule, hw_clocks from, hw_clocks to);
+// Print one line per rule; returns the number of rules that failed or
+// were never exercised
+int hw_report(FILE *out, const char *title, EdgeRule *rules, int n);
+
+void hw_fatal(const char *fmt, ...);
+
+#endif
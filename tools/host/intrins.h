@@ -0,0 +1,7 @@
+// Host stand-in for the Keil intrinsics: _nop_ costs one machine cycle.
+#ifndef HOST_INTRINS_H
+#define HOST_INTRINS_H
+
+void _nop_(void);
+
+#endif
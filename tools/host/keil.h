@@ -0,0 +1,28 @@
+// Forced include for firmware sources built on the host (see Makefile).
+// Maps the Keil C51 extensions onto standard C++ so the unmodified .c
+// files compile; sbit/sfr accesses go through the board model in reg52.h.
+#ifndef HOST_KEIL_H
+#define HOST_KEIL_H
+
+// System headers the firmware pulls in, included before int is redefined
+#include <math.h>
+#include <stddef.h>
+
+// Memory-space qualifiers carry no meaning on the host
+#define code
+#define xdata
+#define idata
+#define pdata
+#define bdata
+#define reentrant
+
+// C51 int is 16 bits; keep the firmware's storage widths faithful
+// (arithmetic is still promoted to the host int, as in C51 with INTPROMOTE)
+#define int short
+
+// Empty busy-wait loops get a body that lets simulated time move on
+// (the Makefile rewrites "while(cond);" into "while(cond) HOST_SPIN();")
+#define HOST_SPIN() hw_spin()
+void hw_spin(void);
+
+#endif
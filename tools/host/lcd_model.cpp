@@ -0,0 +1,158 @@
+// HD44780 model (see lcd_model.h).  Timings are the slower of the HD44780
+// and HD44780U datasheet figures at VCC = 5 V, fosc = 270 kHz.
+#include <string.h>
+#include "lcd_model.h"
+
+LcdModel lcd = { {0}, {0}, 0, 0, {
+    { "tPOR",   "power on -> first write EN rise",  15000000 },
+    { "tAS",    "RS/RW change -> EN rise",               140 },
+    { "tAH",    "EN fall -> RS/RW change",                10 },
+    { "PWEH",   "EN high time",                          450 },
+    { "tcycE",  "EN rise -> next EN rise",              1000 },
+    { "tDSW",   "data change -> EN fall",                195 },
+    { "tH",     "EN fall -> data change",                 10 },
+    { "tEXEC",  "instruction/data -> next EN rise",    37000 },
+    { "tCLEAR", "clear/home -> next EN rise",        1520000 },
+} };
+
+// RS, RW and EN come out of reset high (port latches = 0xFF)
+static int rs = 1, rw = 1, en = 1;
+static unsigned char bus = 0xFF;
+static hw_clocks rs_rw_change, data_change, en_rise, en_fall, write_fall;
+static bool seen_en_rise, seen_en_fall, written;
+static int write_kind;                  // LCD_T_EXEC or LCD_T_CLEAR for the last write
+
+static unsigned char ac;                // address counter
+static bool to_cgram;                   // last address set was CGRAM
+static bool increment = true, display_on;
+
+void lcd_power_on(void) {
+    // Internal reset: display cleared and off, cursor moves right
+    memset(lcd.ddram, ' ', sizeof(lcd.ddram));
+    memset(lcd.cgram, 0, sizeof(lcd.cgram));
+    ac = 0;
+    to_cgram = false;
+    increment = true;
+    display_on = false;
+}
+
+static void step_ac(void) {
+    if(to_cgram) {
+        ac = (ac + (increment ? 1 : -1)) & 0x3F;
+    } else if(increment) {
+        ac = ac == 0x27 ? 0x40 : ac == 0x67 ? 0x00 : ac + 1;
+    } else {
+        ac = ac == 0x40 ? 0x27 : ac == 0x00 ? 0x67 : ac - 1;
+    }
+}
+
+static void execute(int is_data, unsigned char v) {
+    lcd.bytes++;
+    write_kind = LCD_T_EXEC;
+    if(is_data) {
+        if(to_cgram) lcd.cgram[ac & 0x3F] = v;
+        else lcd.ddram[ac & 0x7F] = v;
+        step_ac();
+    } else if(v & 0x80) {
+        ac = v & 0x7F;
+        to_cgram = false;
+    } else if(v & 0x40) {
+        ac = v & 0x3F;
+        to_cgram = true;
+    } else if(v & 0x20) {
+        // function set: the model always runs 8-bit, two lines
+    } else if(v & 0x10) {
+        if(!(v & 0x08)) {               // cursor shift (display shift is not modelled)
+            bool was = increment;
+            increment = (v & 0x04) != 0;
+            step_ac();
+            increment = was;
+        }
+    } else if(v & 0x08) {
+        display_on = (v & 0x04) != 0;
+    } else if(v & 0x04) {
+        increment = (v & 0x02) != 0;
+    } else if(v & 0x02) {
+        ac = 0;
+        to_cgram = false;
+        write_kind = LCD_T_CLEAR;
+    } else if(v & 0x01) {
+        memset(lcd.ddram, ' ', sizeof(lcd.ddram));
+        ac = 0;
+        to_cgram = false;
+        increment = true;
+        write_kind = LCD_T_CLEAR;
+    }
+}
+
+void lcd_rs(int level) {
+    rs = level;
+    if(en) lcd.glitches++;
+    else if(seen_en_fall) hw_rule(lcd.rules[LCD_T_AH], en_fall, hw_now);
+    rs_rw_change = hw_now;
+}
+
+void lcd_rw(int level) {
+    rw = level;
+    if(en) lcd.glitches++;
+    else if(seen_en_fall) hw_rule(lcd.rules[LCD_T_AH], en_fall, hw_now);
+    rs_rw_change = hw_now;
+}
+
+void lcd_data(unsigned char value) {
+    bus = value;
+    if(!en && seen_en_fall) hw_rule(lcd.rules[LCD_T_H], en_fall, hw_now);
+    data_change = hw_now;
+}
+
+void lcd_en(int level) {
+    en = level;
+    if(level) {
+        if(!rw) {
+            hw_rule(lcd.rules[LCD_T_AS], rs_rw_change, hw_now);
+            if(seen_en_rise) hw_rule(lcd.rules[LCD_T_CYCE], en_rise, hw_now);
+            if(written) hw_rule(lcd.rules[write_kind], write_fall, hw_now);
+            else hw_rule(lcd.rules[LCD_T_POR], 0, hw_now);
+        }
+        en_rise = hw_now;
+        seen_en_rise = true;
+    } else {
+        if(!rw) {
+            // Data is latched on the falling edge
+            if(seen_en_rise) hw_rule(lcd.rules[LCD_T_PWEH], en_rise, hw_now);
+            hw_rule(lcd.rules[LCD_T_DSW], data_change, hw_now);
+            execute(rs, bus);
+            write_fall = hw_now;
+            written = true;
+        }
+        en_fall = hw_now;
+        seen_en_fall = true;
+    }
+}
+
+// CGRAM characters as superscript digits, the A00 ROM's few non-ASCII
+// glyphs the firmware could use, '?' for anything else
+static void put_char(std::string &s, unsigned char c) {
+    static const char *const cg[8] = { "⁰", "¹", "²", "³", "⁴", "⁵", "⁶", "⁷" };
+    if(c < 0x10) s += cg[c & 7];
+    else if(c == 0x5C) s += "¥";
+    else if(c == 0x7E) s += "→";
+    else if(c == 0x7F) s += "←";
+    else if(c == 0xA5) s += "·";
+    else if(c == 0xDF) s += "°";
+    else if(c == 0xFF) s += "█";
+    else if(c >= 0x20 && c < 0x7E) s += (char)c;
+    else s += '?';
+}
+
+std::string lcd_frame(void) {
+    std::string s;
+    int row, col;
+    if(!display_on) return "(display off)\n";
+    for(row = 0; row < 2; row++) {
+        s += '|';
+        for(col = 0; col < 16; col++) put_char(s, lcd.ddram[(row ? 0x40 : 0x00) + col]);
+        s += "|\n";
+    }
+    return s;
+}
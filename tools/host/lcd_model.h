@@ -0,0 +1,36 @@
+// HD44780 (LCD1602) on the host: write-only 8-bit bus, DDRAM/CGRAM and
+// instruction execution times (tools/host).
+#ifndef HOST_LCD_MODEL_H
+#define HOST_LCD_MODEL_H
+
+#include <string>
+#include "hw.h"
+
+enum {
+    LCD_T_POR, LCD_T_AS, LCD_T_AH, LCD_T_PWEH, LCD_T_CYCE, LCD_T_DSW, LCD_T_H,
+    LCD_T_EXEC, LCD_T_CLEAR,
+    LCD_RULES
+};
+
+struct LcdModel {
+    unsigned char ddram[0x80];
+    unsigned char cgram[64];
+    unsigned long bytes;        // bytes latched (commands + data)
+    unsigned long glitches;     // RS/RW/data changed while EN was high
+    EdgeRule rules[LCD_RULES];
+};
+
+extern LcdModel lcd;
+
+void lcd_power_on(void);
+// The two visible rows as UTF-8 text, CGRAM characters shown as 0..7
+// superscripts; "(display off)" when the display is switched off
+std::string lcd_frame(void);
+
+// Pin events from the board wiring
+void lcd_rs(int level);
+void lcd_rw(int level);
+void lcd_en(int level);
+void lcd_data(unsigned char value);
+
+#endif
@@ -0,0 +1,70 @@
+// Host stand-in for Keil's reg52.h (tools/host).
+//
+// Port pins and the timer/interrupt control bits are small objects rather
+// than plain bytes, so that every access the firmware makes goes through
+// the board model in hw.cpp: pin writes become timestamped edges seen by
+// the DS1302 and HD44780 models, pin reads return what those devices (or
+// the keys) drive, and TR0/TR2/ET0/ET2/EA start timers and gate the
+// interrupt service routines.
+#ifndef __REG52_H__
+#define __REG52_H__
+
+void hw_pin_write(unsigned char port, unsigned char bit, unsigned char level);
+unsigned char hw_pin_read(unsigned char port, unsigned char bit);
+void hw_port_write(unsigned char port, unsigned char value);
+unsigned char hw_port_read(unsigned char port);
+void hw_bit_write(unsigned char id, unsigned char level);
+unsigned char hw_bit_read(unsigned char id);
+
+struct Pin {
+    unsigned char port, bit;
+
+    Pin &operator=(unsigned char level) { hw_pin_write(port, bit, level != 0); return *this; }
+    Pin &operator=(const Pin &other) { return *this = (unsigned char)other; }
+    operator unsigned char() const { return hw_pin_read(port, bit); }
+};
+
+struct Port {
+    unsigned char id;
+
+    constexpr Port(unsigned char n) : id(n) {}
+    Port &operator=(unsigned char value) { hw_port_write(id, value); return *this; }
+    operator unsigned char() const { return hw_port_read(id); }
+};
+
+// A template so that "P3^1" matches the literal exactly (keil.h turns
+// int into short); otherwise the built-in ^ on the converted port byte
+// is an equally good candidate
+template <typename T>
+inline Pin operator^(const Port &port, T bit) {
+    Pin pin = { port.id, (unsigned char)bit };
+    return pin;
+}
+
+struct SfrBit {
+    unsigned char id;
+
+    constexpr SfrBit(unsigned char n) : id(n) {}
+    SfrBit &operator=(unsigned char level) { hw_bit_write(id, level != 0); return *this; }
+    operator unsigned char() const { return hw_bit_read(id); }
+};
+
+enum {
+    HW_BIT_EA, HW_BIT_ET0, HW_BIT_ET2, HW_BIT_TR0, HW_BIT_TR2,
+    HW_BIT_TF0, HW_BIT_TF2, HW_BIT_EXF2, HW_BIT_PT0, HW_BIT_PT2, HW_BIT_PS,
+    HW_BIT_COUNT
+};
+
+extern Port P0, P1, P2, P3;
+extern SfrBit EA, ET0, ET2, TR0, TR2, TF0, TF2, EXF2, PT0, PT2, PS;
+
+// Byte registers the firmware only writes or reads back: the model looks
+// at TH0/TL0 when Timer0 starts or its ISR returns, and at RCAP2H/L on
+// each Timer2 overflow
+extern unsigned char TMOD, TCON, IE, IP, PCON, TH0, TL0, TH1, TL1;
+extern unsigned char T2CON, TH2, TL2, RCAP2H, RCAP2L;
+
+typedef unsigned char bit;
+#define sbit static Pin
+
+#endif
@@ -0,0 +1,214 @@
+// Scenario runner: boots the whole firmware on the board model, presses
+// keys on a schedule and writes down every distinct screen, the key
+// presses in between with the LCD/DS1302 bytes each stretch cost, and the
+// RTC state at the end.  make compares the output with golden/<name>.txt.
+//
+//   scenario.bin             list the scenarios
+//   scenario.bin <name>      run one and print its log
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "hw.h"
+#include "ds1302_model.h"
+#include "lcd_model.h"
+#include "firmware.h"
+
+#define KEY_HOLD_MS 150
+
+enum { K1 = 1, K2, K3, K4 };
+// Key number -> P3 bit (K1 is P3.1, K2 is P3.0, K3 is P3.2, K4 is P3.3)
+static const unsigned char key_bit[5] = { 0, 1, 0, 2, 3 };
+
+struct Press {
+    unsigned ms;            // time of the press after power-on
+    unsigned char key;      // K1..K4, 0 ends the list
+};
+
+struct Scenario {
+    const char *name;
+    void (*setup)(void);
+    unsigned end_ms;
+    Press presses[16];
+};
+
+// ---------------------------------------------------------------------------
+// Starting states of the DS1302
+// ---------------------------------------------------------------------------
+static void rtc_time(unsigned char yy, unsigned char mo, unsigned char dd, unsigned char wd,
+                     unsigned char hh, unsigned char mi, unsigned char ss) {
+    unsigned char t[7] = { ss, mi, hh, dd, mo, wd, yy };
+    memcpy(rtc.reg, t, 7);
+}
+
+// Battery kept the clock and the settings: alarm 07:00 on, 24 h, no chime
+static void rtc_settings(void) {
+    static const unsigned char ram[7] = { 0xAA, 7, 0, 1, 0, 0, 0x00 };
+    memcpy(rtc.ram, ram, sizeof(ram));
+}
+
+// ... and the last log entry is a power-on the day before
+static void setup_valid(void) {
+    static const unsigned char boot[4] = { 0x16, 0x14, 0xE0, 1 };  // 06-14 08:00
+    rtc_time(0x25, 0x06, 0x15, 0x07, 0x09, 0x30, 0x00);
+    rtc_settings();
+    rtc.ram[6] = 0x11;
+    memcpy(rtc.ram + 7, boot, sizeof(boot));
+}
+
+// New battery: oscillator halted, registers and RAM hold garbage
+static void setup_invalid(void) {
+    rtc_time(0x00, 0x00, 0x00, 0x00, 0x3F, 0x7F, 0xA5);
+    memset(rtc.ram, 0xC3, sizeof(rtc.ram));
+}
+
+static void setup_alarm(void) {
+    rtc_time(0x25, 0x06, 0x16, 0x01, 0x06, 0x59, 0x57);
+    rtc_settings();
+}
+
+// Alarm saved as 08:00; the editor will move it to 07:00 without saving
+static void setup_alarm_edit(void) {
+    rtc_time(0x25, 0x06, 0x16, 0x01, 0x06, 0x59, 0x50);
+    rtc_settings();
+    rtc.ram[1] = 8;
+}
+
+static void setup_afternoon(void) {
+    rtc_time(0x25, 0x06, 0x15, 0x07, 0x13, 0x45, 0x00);
+    rtc_settings();
+}
+
+// Hourly chime on, a few seconds before 10:00
+static void setup_chime(void) {
+    rtc_time(0x25, 0x06, 0x15, 0x07, 0x09, 0x59, 0x56);
+    rtc_settings();
+    rtc.ram[5] = 1;
+}
+
+static const Scenario scenarios[] = {
+    { "boot_valid", setup_valid, 4000, { { 0, 0 } } },
+    { "boot_invalid", setup_invalid, 5000, { { 0, 0 } } },
+    // Rings at 07:00:00; K2 dismisses it (and, being on the time screen,
+    // also switches to big digits), then K1 twice to the history screen
+    { "alarm_ring_dismiss", setup_alarm, 14000, {
+        { 8000, K2 }, { 11000, K1 }, { 12000, K1 }, { 0, 0 } } },
+    // K1 x3 opens the alarm editor, K4 moves the hour to 07 unsaved; the
+    // alarm fires on the edited value and K2 stops it.  RAM 1 must still
+    // hold the saved 08
+    { "alarm_edit_unsaved", setup_alarm_edit, 15000, {
+        { 2000, K1 }, { 3000, K1 }, { 4000, K1 }, { 5000, K4 }, { 13000, K2 }, { 0, 0 } } },
+    // Two beeps at 10:00, once only for the whole minute
+    { "hourly_chime", setup_chime, 8000, { { 0, 0 } } },
+    { "hour_12_24", setup_afternoon, 7000, {
+        { 3000, K3 }, { 5000, K3 }, { 0, 0 } } },
+    // K1 x3 to the alarm editor (it opens on arrival) and once more to
+    // leave it; after the 1 s "saved" message K1 to the time editor, K2 x3
+    // to the hour, K3 x2, K2 to the minute, K4, K1 saves and returns to
+    // the time screen
+    { "time_set", setup_valid, 19000, {
+        { 3000, K1 }, { 4000, K1 }, { 5000, K1 }, { 6000, K1 }, { 8000, K1 },
+        { 9000, K2 }, { 10000, K2 }, { 11000, K2 }, { 12000, K3 }, { 13000, K3 },
+        { 14000, K2 }, { 15000, K4 }, { 16000, K1 }, { 0, 0 } } },
+};
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+static const Scenario *running;
+static unsigned next_press;
+static std::string out, last_frame;
+static unsigned long mark_lcd, mark_rtc, beeps;
+static jmp_buf finished;
+
+static void frame(void) {
+    std::string f = lcd_frame();
+    if(f == last_frame) return;
+    last_frame = f;
+    out += f + "\n";
+}
+
+static void mark(const char *what) {
+    char line[80];
+    snprintf(line, sizeof(line), "%-6s lcd %5lu  rtc %5lu\n", what, lcd.bytes - mark_lcd, rtc.bytes - mark_rtc);
+    out += line;
+    mark_lcd = lcd.bytes;
+    mark_rtc = rtc.bytes;
+}
+
+static void beep(int on) {
+    if(on) beeps++;
+}
+
+static void release(void) {
+    hw_key(key_bit[running->presses[next_press - 1].key], 0);
+}
+
+static void press(void) {
+    const Press &p = running->presses[next_press++];
+    char what[8];
+    snprintf(what, sizeof(what), "> K%u", p.key);
+    mark(what);
+    hw_key(key_bit[p.key], 1);
+    hw_at(hw_now + HW_MS(KEY_HOLD_MS), release);
+    if(running->presses[next_press].key) hw_at(HW_MS(running->presses[next_press].ms), press);
+}
+
+static void finish(void) {
+    longjmp(finished, 1);
+}
+
+static void report(void) {
+    char line[160];
+    int i;
+    mark("= end");
+    snprintf(line, sizeof(line), "total  lcd %5lu  rtc %5lu  beeps %lu\n", lcd.bytes, rtc.bytes, beeps);
+    out += line;
+    rtc_update();
+    snprintf(line, sizeof(line), "rtc    20%02x-%02x-%02x %02x:%02x:%02x  day %x  wp %d\n",
+             rtc.reg[6], rtc.reg[4], rtc.reg[3], rtc.reg[2], rtc.reg[1], rtc.reg[0],
+             rtc.reg[5], rtc.reg[7] >> 7);
+    out += line;
+    out += "ram   ";
+    for(i = 0; i < 31; i++) {
+        snprintf(line, sizeof(line), " %02x", rtc.ram[i]);
+        out += line;
+    }
+    out += "\n";
+    if(rtc.faults || lcd.glitches) {
+        snprintf(line, sizeof(line), "bus faults %lu, LCD glitches %lu\n", rtc.faults, lcd.glitches);
+        out += line;
+    }
+}
+
+int main(int argc, char **argv) {
+    const Scenario *s = 0;
+    size_t i;
+
+    for(i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        if(argc > 1 && strcmp(argv[1], scenarios[i].name) == 0) s = &scenarios[i];
+        if(argc < 2) printf("%s\n", scenarios[i].name);
+    }
+    if(argc < 2) return 0;
+    if(!s) {
+        fprintf(stderr, "unknown scenario %s\n", argv[1]);
+        return 2;
+    }
+
+    running = s;
+    rtc_power_on();
+    lcd_power_on();
+    s->setup();
+    hw_vector(1, LCD_Isr);
+    hw_vector(5, SoftClock_Isr);
+    hw_lcd_idle = frame;
+    hw_beep_changed = beep;
+    if(s->presses[0].key) hw_at(HW_MS(s->presses[0].ms), press);
+    hw_at(HW_MS(s->end_ms), finish);
+
+    out = std::string("scenario ") + s->name + "\n\n";
+    if(!setjmp(finished)) fw_main();
+    report();
+    fputs(out.c_str(), stdout);
+    return 0;
+}
@@ -0,0 +1,83 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+"""Per-module ROM/RAM usage from a BL51 .m51 map file.
+
+Usage: python tools/m51size.py Listings/22222.m51
+
+CODE counts ?PR? (functions) and ?CO? (constants) segments, DATA/IDATA/XDATA/
+BIT count the module's static segments.  OVL is the largest overlaid local
+block of any function in the module (_DATA_GROUP_ is shared, so these do not
+add up).
+
+Optional: the uVision project carries this command as the After-Build
+"Run #1" step but leaves it unticked, so the firmware still builds on a PC
+without Python.  Tick it under Options for Target > User to run it on every
+build, or run the command above by hand after a build.
+"""
+import re
+import sys
+
+SEG_RE = re.compile(r'^\s+(CODE|DATA|IDATA|XDATA|BIT)\s+([0-9A-F]+)H(?:\.\d)?\s+'
+                    r'([0-9A-F]+)H(?:\.\d)?\s+\w+\s+(\S+)\s*$')
+OVL_RE = re.compile(r'^(\?PR\?\S+)\s+([0-9A-F]+)H\s+([0-9A-F]+)H\s*$')
+COLS = ('CODE', 'DATA', 'IDATA', 'XDATA', 'BIT', 'OVL')
+
+
+SEG_CLASSES = ('PR', 'CO', 'DT', 'ID', 'XD', 'PD', 'BI', 'BA')
+
+
+def module_of(segment):
+    # ?PR?FUNC?MODULE, ?CO?MODULE, ?DT?MODULE, ?DT?FUNC?MODULE ...
+    parts = segment.lstrip('?').split('?')
+    if len(parts) >= 2 and parts[0] in SEG_CLASSES:
+        return parts[-1]
+    return '(runtime)'
+
+
+def main(path):
+    usage = {}
+    overlay = 0
+    in_map = False
+    total = None
+    with open(path, 'rb') as f:
+        text = f.read().decode('latin-1')
+    for line in text.splitlines():
+        if 'LINK MAP OF MODULE' in line:
+            in_map = True
+        elif 'OVERLAY MAP OF MODULE' in line or 'SYMBOL TABLE OF MODULE' in line:
+            in_map = False
+        if line.startswith('Program Size:'):
+            total = line.strip()
+
+        m = SEG_RE.match(line) if in_map else None
+        if m:
+            kind, _, length, seg = m.groups()
+            length = int(length, 16)
+            if seg == '_DATA_GROUP_':
+                overlay = length
+                continue
+            if kind == 'DATA' and seg.startswith('"REG'):
+                continue
+            row = usage.setdefault(module_of(seg), dict.fromkeys(COLS, 0))
+            row[kind] += length
+            continue
+
+        m = OVL_RE.match(line)
+        if m:
+            row = usage.setdefault(module_of(m.group(1)), dict.fromkeys(COLS, 0))
+            row['OVL'] = max(row['OVL'], int(m.group(3), 16))
+
+    print('%-12s' % 'MODULE' + ''.join('%7s' % c for c in COLS))
+    for name in sorted(usage, key=lambda n: -usage[n]['CODE']):
+        row = usage[name]
+        print('%-12s' % name + ''.join('%7d' % row[c] for c in COLS))
+    print('%-12s%7d  (overlaid locals, shared by all modules)' % ('_DATA_GROUP_', overlay))
+    if total:
+        print(total)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        sys.stderr.write(__doc__)
+        sys.exit(1)
+    main(sys.argv[1])
@@ -0,0 +1,122 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+"""Build the UI string pool from tools/uitext.txt.
+
+Usage: python tools/mktext.py [tools/uitext.txt]
+
+Writes textpool.h / textpool.c next to main.c.  Each distinct word is stored
+once in text_pool[] (NUL-terminated, a word that is the tail of a longer one
+points into it).  Each message is a run of pool offsets in text_script[]
+ended by TEXT_END, and a message that is the tail of a longer one shares it.
+TXT_xxx is the message's offset in text_script[].
+
+Both kinds of offset are one byte, which caps the tables: text_pool[] at
+POOL_MAX bytes (a word starting at 0xFF would read as TEXT_END) and
+text_script[] at SCRIPT_MAX.  Going over stops the generator with an error
+rather than wrapping; widening the offsets to u16 would double the scripts.
+The generated files are checked in, so the Keil build does not need Python:
+run this by hand after editing uitext.txt.
+"""
+import os
+import sys
+
+TEXT_END = 0xFF
+POOL_MAX = 255
+SCRIPT_MAX = 256
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+
+
+def read_messages(path):
+    msgs = []
+    with open(path) as f:
+        for no, line in enumerate(f, 1):
+            line = line.rstrip('\r\n')
+            if not line.strip() or line.lstrip().startswith('#'):
+                continue
+            name, _, text = line.partition(' ')
+            text = text.strip()
+            if len(text) >= 2 and text[0] == text[-1] == '"':
+                text = text[1:-1].rstrip(' ')
+            # leading or double spaces become empty words
+            words = text.split(' ') if text else []
+            if len(text) > 16:
+                sys.exit('%s:%d: "%s" is wider than the display' % (path, no, text))
+            if any(n == name for n, _ in msgs):
+                sys.exit('%s:%d: duplicate name %s' % (path, no, name))
+            msgs.append((name, words))
+    return msgs
+
+
+def pack(items, sep):
+    """Place items longest first; an item that is the tail of one already
+    placed reuses it.  Returns (flat list, {item: offset})."""
+    flat, where, placed = [], {}, []
+    for item in sorted(set(items), key=lambda i: (-len(i), i)):
+        for start, other in placed:
+            if other[len(other) - len(item):] == item:
+                where[item] = start + len(other) - len(item)
+                break
+        else:
+            where[item] = len(flat)
+            placed.append((len(flat), item))
+            flat.extend(item)
+            flat.append(sep)
+    return flat, where
+
+
+def c_words(pool):
+    # one word per string piece; the array size drops the final implicit NUL
+    words = ''.join(c if c else '\n' for c in pool).split('\n')[:-1]
+    esc = lambda w: w.replace('\\', '\\\\').replace('"', '\\"')
+    return '\n'.join('    "%s\\0"' % esc(w) for w in words)
+
+
+def rows(values, per_line=12):
+    return ',\n'.join('    ' + ', '.join(values[i:i + per_line])
+                      for i in range(0, len(values), per_line))
+
+
+def main(path):
+    msgs = read_messages(path)
+
+    pool, word_at = pack([w for _, ws in msgs for w in ws], 0)
+    if len(pool) > POOL_MAX:
+        sys.exit('text_pool is %d bytes, over the %d-byte cap of its u8 offsets;'
+                 ' shorten or reuse words in %s' % (len(pool), POOL_MAX, path))
+
+    scripts = dict((name, tuple(word_at[w] for w in ws)) for name, ws in msgs)
+    script, msg_at = pack(scripts.values(), TEXT_END)
+    if len(script) > SCRIPT_MAX:
+        sys.exit('text_script is %d bytes, over the %d-byte cap of the u8 TXT_xxx ids;'
+                 ' drop or merge messages in %s' % (len(script), SCRIPT_MAX, path))
+
+    head = ('// Generated by tools/mktext.py from tools/uitext.txt -- do not edit.\n'
+            '// pool %d/%d bytes, scripts %d/%d bytes, %d messages\n'
+            % (len(pool), POOL_MAX, len(script), SCRIPT_MAX, len(msgs)))
+
+    with open(os.path.join(ROOT, 'textpool.h'), 'w') as f:
+        f.write(head)
+        f.write('#ifndef __TEXTPOOL_H__\n#define __TEXTPOOL_H__\n\n'
+                '#include "common.h"\n\n')
+        f.write('#define TEXT_END            0x%02X\n\n' % TEXT_END)
+        for name, ws in msgs:
+            f.write('#define %-19s 0x%02X    // %s\n'
+                    % ('TXT_' + name, msg_at[scripts[name]],
+                       ('"%s"' % ' '.join(ws)) if ws else '(blank)'))
+        f.write('\nextern char code text_pool[%d];\n' % len(pool))
+        f.write('extern u8 code text_script[%d];\n\n#endif\n' % len(script))
+
+    with open(os.path.join(ROOT, 'textpool.c'), 'w') as f:
+        f.write(head)
+        f.write('#include "textpool.h"\n\n')
+        f.write('char code text_pool[%d] =\n%s;\n\n' % (len(pool), c_words(pool)))
+        f.write('u8 code text_script[%d] = {\n%s\n};\n'
+                % (len(script), rows(['0x%02X' % b for b in script])))
+
+    print('text_pool %d/%d bytes, text_script %d/%d bytes, %d messages'
+          % (len(pool), POOL_MAX, len(script), SCRIPT_MAX, len(msgs)))
+
+
+if __name__ == '__main__':
+    main(sys.argv[1] if len(sys.argv) > 1 else
+         os.path.join(os.path.dirname(os.path.abspath(__file__)), 'uitext.txt'))